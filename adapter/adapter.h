@@ -2,6 +2,7 @@
 #define ADAPTER_H
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/timer.h>
 
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/dofs/dof_tools.h>
@@ -14,6 +15,7 @@
 
 #include "q_equidistant.h"
 #include "time.h"
+#include "trace.h"
 
 namespace Adapter
 {
@@ -212,6 +214,16 @@ namespace Adapter
     unsigned int
     get_block_data_id(const unsigned int face_id) const;
 
+    /**
+     * @brief attach_timer Measures the phases of the coupling in separate
+     *        sections of @p timer: the evaluation of the write data ('Write
+     *        coupling data'), the time spent in preCICE including the wait for
+     *        the other participants ('preCICE advance') and the saving and
+     *        reloading of the state variables ('Save state', 'Reload state').
+     *        The sections may be nested in a section of the solver.
+     */
+    void
+    attach_timer(TimerOutput &timer);
 
     // public precice solverinterface, needed in order to steer the time loop
     // inside the solver.
@@ -262,6 +274,9 @@ namespace Adapter
     std::shared_ptr<const Quadrature<dim - 1>> read_quadrature;
     std::shared_ptr<const Mapping<dim>>        mapping;
 
+    // Optional timer, see attach_timer()
+    TimerOutput *timer = nullptr;
+
     /**
      * @brief set_mesh_vertices Define a vertex coupling mesh for preCICE coupling
      *
@@ -321,6 +336,8 @@ namespace Adapter
     std::shared_ptr<const Quadrature<dim - 1>> read_quadrature_,
     const VectorType &                         dealii_to_precice)
   {
+    const TraceScope trace("Adapter initialize");
+
     AssertThrow(
       dim == precice.getDimensions(),
       ExcMessage("The dimension of your solver needs to be consistent with the "
@@ -389,11 +406,24 @@ namespace Adapter
     const double           computed_timestep_length)
   {
     if (precice.isWriteDataRequired(computed_timestep_length))
-      write_all_quadrature_nodes(dealii_to_precice, dof_handler);
+      {
+        if (timer)
+          timer->enter_subsection("Write coupling data");
+        write_all_quadrature_nodes(dealii_to_precice, dof_handler);
+        if (timer)
+          timer->leave_subsection("Write coupling data");
+      }
 
     // Here, we need to specify the computed time step length and pass it to
     // preCICE
-    precice.advance(computed_timestep_length);
+    if (timer)
+      timer->enter_subsection("preCICE advance");
+    {
+      const TraceScope trace("preCICE advance");
+      precice.advance(computed_timestep_length);
+    }
+    if (timer)
+      timer->leave_subsection("preCICE advance");
 
     if (shared_memory_parallel && precice.isReadDataAvailable())
       precice.readBlockVectorData(read_data_id,
@@ -422,10 +452,15 @@ namespace Adapter
     if (precice.isActionRequired(
           precice::constants::actionWriteIterationCheckpoint()))
       {
+        const TraceScope trace("Save state");
+        if (timer)
+          timer->enter_subsection("Save state");
         old_state_data.resize(state_variables.size());
 
         for (uint i = 0; i < state_variables.size(); ++i)
           old_state_data[i] = *(state_variables[i]);
+        if (timer)
+          timer->leave_subsection("Save state");
 
         old_time_value = time_class.current();
 
@@ -451,8 +486,13 @@ namespace Adapter
                ExcMessage(
                  "state_variables are not the same as previously saved."));
 
+        const TraceScope trace("Reload state");
+        if (timer)
+          timer->enter_subsection("Reload state");
         for (uint i = 0; i < state_variables.size(); ++i)
           *(state_variables[i]) = old_state_data[i];
+        if (timer)
+          timer->leave_subsection("Reload state");
 
         // Here, we expect the time class to offer an option to specify a
         // given time value.
@@ -471,6 +511,8 @@ namespace Adapter
     const VectorType &     data,
     const DoFHandler<dim> &dof_handler)
   {
+    const TraceScope trace("Write coupling data");
+
     FEFaceValues<dim>           fe_face_values(*mapping,
                                      dof_handler.get_fe(),
                                      *write_quadrature,
@@ -604,6 +646,15 @@ namespace Adapter
 
 
 
+  template <int dim, typename VectorType, typename ParameterClass>
+  void
+  Adapter<dim, VectorType, ParameterClass>::attach_timer(TimerOutput &timer)
+  {
+    this->timer = &timer;
+  }
+
+
+
   template <int dim, typename VectorType, typename ParameterClass>
   void
   Adapter<dim, VectorType, ParameterClass>::print_info() const
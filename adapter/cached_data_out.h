@@ -0,0 +1,300 @@
+#ifndef CACHED_DATA_OUT_H
+#define CACHED_DATA_OUT_H
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/derivative_form.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_component_interpretation.h>
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/data_postprocessor.h>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  namespace internal
+  {
+    // Gives access to the patches of a DataOut object
+    template <int dim>
+    class PatchExtractor : public DataOut<dim>
+    {
+    public:
+      using DataOut<dim>::get_patches;
+      using DataOut<dim>::get_dataset_names;
+      using DataOut<dim>::get_nonscalar_data_ranges;
+    };
+  } // namespace internal
+
+  /**
+   * @brief The CachedDataOut class generates output patches on the reference
+   *        configuration, whose geometry is built only once.
+   *
+   *        The constructor builds the patches (vertices and connectivity) by
+   *        a regular DataOut and stores the DoF indices and the inverse
+   *        Jacobians at the patch points of all cells. Afterwards,
+   *        build_patches() only evaluates the solution and the postprocessor
+   *        at the patch points by table lookups, i.e., without the mapping and
+   *        FEValues. The deformation is not applied to the patches, but has to
+   *        be applied in the viewer (e.g. 'Warp By Vector' in ParaView).
+   *
+   *        Copies share the cached data, so that each output task can work on
+   *        its own copy of the patches. The postprocessor may only require
+   *        the values and gradients of the solution.
+   */
+  template <int dim>
+  class CachedDataOut : public DataOutInterface<dim>
+  {
+  public:
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  dof_handler DoFHandler of the solution vectors
+     * @param[in]  mapping Mapping of the reference configuration
+     * @param[in]  postprocessor Postprocessor, which computes the output
+     *             quantities of the solution
+     * @param[in]  n_subdivisions Number of subdivisions of each cell
+     */
+    CachedDataOut(const DoFHandler<dim> &                       dof_handler,
+                  const Mapping<dim> &                          mapping,
+                  std::shared_ptr<const DataPostprocessor<dim>> postprocessor,
+                  const unsigned int                            n_subdivisions);
+
+    /**
+     * @brief build_patches Evaluates the postprocessor for @p solution at
+     *        the patch points
+     */
+    template <typename VectorType>
+    void
+    build_patches(const VectorType &solution);
+
+  protected:
+    virtual const std::vector<DataOutBase::Patch<dim, dim>> &
+    get_patches() const override
+    {
+      return patches;
+    }
+
+    virtual std::vector<std::string>
+    get_dataset_names() const override
+    {
+      return cache->dataset_names;
+    }
+
+    virtual std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+    get_nonscalar_data_ranges() const override
+    {
+      return cache->nonscalar_data_ranges;
+    }
+
+  private:
+    // The data, which is shared by all copies
+    struct Cache
+    {
+      std::shared_ptr<const DataPostprocessor<dim>> postprocessor;
+
+      unsigned int n_components;
+      unsigned int n_output_components;
+
+      // Values and gradients of the shape functions at the patch points of
+      // the reference cell and the vector component of each shape function
+      FullMatrix<double>                       shape_values;
+      std::vector<std::vector<Tensor<1, dim>>> shape_gradients;
+      std::vector<unsigned int>                shape_components;
+
+      // DoF indices and inverse Jacobians at the patch points of all cells
+      std::vector<std::vector<types::global_dof_index>>     dof_indices;
+      std::vector<std::vector<DerivativeForm<1, dim, dim>>> inverse_jacobians;
+
+      std::vector<std::string> dataset_names;
+      std::vector<
+        std::tuple<unsigned int,
+                   unsigned int,
+                   std::string,
+                   DataComponentInterpretation::DataComponentInterpretation>>
+        nonscalar_data_ranges;
+    };
+
+    std::shared_ptr<const Cache> cache;
+
+    std::vector<DataOutBase::Patch<dim, dim>> patches;
+  };
+
+
+
+  template <int dim>
+  CachedDataOut<dim>::CachedDataOut(
+    const DoFHandler<dim> &                       dof_handler,
+    const Mapping<dim> &                          mapping,
+    std::shared_ptr<const DataPostprocessor<dim>> postprocessor,
+    const unsigned int                            n_subdivisions)
+  {
+    const UpdateFlags supported_flags = update_values | update_gradients;
+    AssertThrow((postprocessor->get_needed_update_flags() | supported_flags) ==
+                  supported_flags,
+                ExcMessage("The postprocessor of the cached output may only "
+                           "require values and gradients"));
+
+    auto new_cache           = std::make_shared<Cache>();
+    new_cache->postprocessor = postprocessor;
+
+    // Build the patches once by a regular DataOut, which also determines the
+    // names and the layout of the output quantities
+    {
+      const Vector<double> zero_solution(dof_handler.n_dofs());
+
+      internal::PatchExtractor<dim> data_out;
+      data_out.attach_dof_handler(dof_handler);
+      data_out.add_data_vector(zero_solution, *postprocessor);
+      data_out.build_patches(mapping,
+                             n_subdivisions,
+                             DataOut<dim>::curved_boundary);
+
+      patches                          = data_out.get_patches();
+      new_cache->dataset_names         = data_out.get_dataset_names();
+      new_cache->nonscalar_data_ranges = data_out.get_nonscalar_data_ranges();
+    }
+
+    // DataOut evaluates the data at these points
+    const QIterated<dim> patch_points(QTrapez<1>(), n_subdivisions);
+    const unsigned int   n_points = patch_points.size();
+
+    const FiniteElement<dim> &fe            = dof_handler.get_fe();
+    const unsigned int        dofs_per_cell = fe.dofs_per_cell;
+
+    new_cache->n_components        = fe.n_components();
+    new_cache->n_output_components = new_cache->dataset_names.size();
+
+    new_cache->shape_values.reinit(dofs_per_cell, n_points);
+    new_cache->shape_gradients.resize(dofs_per_cell,
+                                      std::vector<Tensor<1, dim>>(n_points));
+    new_cache->shape_components.resize(dofs_per_cell);
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      {
+        new_cache->shape_components[i] = fe.system_to_component_index(i).first;
+        for (unsigned int q = 0; q < n_points; ++q)
+          {
+            new_cache->shape_values(i, q) =
+              fe.shape_value(i, patch_points.point(q));
+            new_cache->shape_gradients[i][q] =
+              fe.shape_grad(i, patch_points.point(q));
+          }
+      }
+
+    FEValues<dim> fe_values(mapping,
+                            fe,
+                            patch_points,
+                            update_inverse_jacobians);
+
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        fe_values.reinit(cell);
+
+        std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+        cell->get_dof_indices(dof_indices);
+        new_cache->dof_indices.push_back(dof_indices);
+
+        std::vector<DerivativeForm<1, dim, dim>> inverse_jacobians(n_points);
+        for (unsigned int q = 0; q < n_points; ++q)
+          inverse_jacobians[q] = fe_values.inverse_jacobian(q);
+        new_cache->inverse_jacobians.push_back(inverse_jacobians);
+      }
+
+    // DataOut generates one patch per active cell in the same order
+    AssertDimension(patches.size(), new_cache->dof_indices.size());
+
+    cache = new_cache;
+  }
+
+
+
+  template <int dim>
+  template <typename VectorType>
+  void
+  CachedDataOut<dim>::build_patches(const VectorType &solution)
+  {
+    const unsigned int n_points      = cache->shape_values.n();
+    const unsigned int dofs_per_cell = cache->shape_values.m();
+
+    DataPostprocessorInputs::Vector<dim> inputs;
+    inputs.solution_values.resize(n_points,
+                                  Vector<double>(cache->n_components));
+    inputs.solution_gradients.resize(
+      n_points, std::vector<Tensor<1, dim>>(cache->n_components));
+
+    // Gradients with respect to the reference coordinates
+    std::vector<std::vector<Tensor<1, dim>>> reference_gradients(
+      n_points, std::vector<Tensor<1, dim>>(cache->n_components));
+
+    std::vector<Vector<double>> computed_quantities(
+      n_points, Vector<double>(cache->n_output_components));
+
+    for (unsigned int c = 0; c < patches.size(); ++c)
+      {
+        for (unsigned int q = 0; q < n_points; ++q)
+          {
+            inputs.solution_values[q] = 0.;
+            for (auto &gradient : reference_gradients[q])
+              gradient = 0.;
+          }
+
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            const double       value = solution(cache->dof_indices[c][i]);
+            const unsigned int component = cache->shape_components[i];
+            for (unsigned int q = 0; q < n_points; ++q)
+              {
+                inputs.solution_values[q](component) +=
+                  value * cache->shape_values(i, q);
+                reference_gradients[q][component] +=
+                  value * cache->shape_gradients[i][q];
+              }
+          }
+
+        // grad u = J^{-T} grad_ref u
+        for (unsigned int q = 0; q < n_points; ++q)
+          {
+            const DerivativeForm<1, dim, dim> &inverse_jacobian =
+              cache->inverse_jacobians[c][q];
+            for (unsigned int component = 0; component < cache->n_components;
+                 ++component)
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  double gradient = 0;
+                  for (unsigned int e = 0; e < dim; ++e)
+                    gradient += inverse_jacobian[e][d] *
+                                reference_gradients[q][component][e];
+                  inputs.solution_gradients[q][component][d] = gradient;
+                }
+          }
+
+        cache->postprocessor->evaluate_vector_field(inputs,
+                                                    computed_quantities);
+
+        for (unsigned int q = 0; q < n_points; ++q)
+          for (unsigned int k = 0; k < cache->n_output_components; ++k)
+            patches[c].data(k, q) = computed_quantities[q](k);
+      }
+  }
+} // namespace Adapter
+
+#endif // CACHED_DATA_OUT_H
@@ -0,0 +1,344 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <deal.II/base/exceptions.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  namespace internal
+  {
+    // Identifies the restart files of this project
+    static const std::string checkpoint_header = "dealii-adapter restart 1";
+
+    template <typename Archive>
+    void
+    save_vector(Archive &archive, const Vector<double> &vector)
+    {
+      archive << vector;
+    }
+
+    template <typename Archive>
+    void
+    save_vector(Archive &archive, const BlockVector<double> &vector)
+    {
+      const unsigned int n_blocks = vector.n_blocks();
+      archive << n_blocks;
+      for (unsigned int b = 0; b < n_blocks; ++b)
+        archive << vector.block(b);
+    }
+
+    template <typename Archive>
+    void
+    load_vector(Archive &archive, Vector<double> &vector)
+    {
+      const types::global_dof_index size = vector.size();
+      archive >> vector;
+      AssertThrow(vector.size() == size,
+                  ExcMessage("The size of a vector in the restart file does "
+                             "not match the discretization"));
+    }
+
+    template <typename Archive>
+    void
+    load_vector(Archive &archive, BlockVector<double> &vector)
+    {
+      unsigned int n_blocks;
+      archive >> n_blocks;
+      AssertThrow(n_blocks == vector.n_blocks(),
+                  ExcMessage("The number of blocks of a vector in the restart "
+                             "file does not match the discretization"));
+      for (unsigned int b = 0; b < n_blocks; ++b)
+        load_vector(archive, vector.block(b));
+      vector.collect_sizes();
+    }
+  } // namespace internal
+
+
+
+  /**
+   * @brief The CheckpointOut class serializes the state of a simulation into
+   *        a binary archive in memory. The data needs to be added in the same
+   *        order as it is read by the CheckpointIn class. Since the archive
+   *        is a copy of the state, the restart file can be written in the
+   *        background by write(), while the time loop proceeds.
+   */
+  class CheckpointOut
+  {
+  public:
+    CheckpointOut();
+
+    /**
+     * @brief save Adds @p data, which needs to be serializable by boost,
+     *        e.g., the Triangulation, Vector<double> or the Time class
+     */
+    template <typename T>
+    void
+    save(const T &data);
+
+    /**
+     * @brief save_dof_numbering Adds the global DoF indices of all active
+     *        cells
+     */
+    template <int dim>
+    void
+    save_dof_numbering(const DoFHandler<dim> &dof_handler);
+
+    /**
+     * @brief save_vectors Adds the vectors @p vectors, e.g., the
+     *        state_variables of a solver
+     */
+    template <typename VectorType>
+    void
+    save_vectors(const std::vector<VectorType *> &vectors);
+
+    /**
+     * @brief write Writes the archive to @p filename. The file is replaced
+     *        atomically, so that an interrupted write does not destroy the
+     *        previous restart file. May be called from any thread.
+     */
+    void
+    write(const std::string &filename) const;
+
+  private:
+    std::ostringstream                               buffer;
+    std::unique_ptr<boost::archive::binary_oarchive> archive;
+  };
+
+
+
+  /**
+   * @brief The CheckpointIn class reads a restart file written by the
+   *        CheckpointOut class. The load functions need to be called in the
+   *        same order as the data has been added to the archive.
+   */
+  class CheckpointIn
+  {
+  public:
+    /**
+     * @brief      Constructor, opens the restart file
+     *
+     * @param[in]  filename Name of the restart file
+     */
+    CheckpointIn(const std::string &filename);
+
+    /**
+     * @brief load Reads @p data, which needs to be serializable by boost
+     */
+    template <typename T>
+    void
+    load(T &data);
+
+    /**
+     * @brief load_triangulation Reads the triangulation including the boundary
+     *        IDs into the empty triangulation @p triangulation. In contrast
+     *        to load(), the triangulation may already be used by a DoFHandler.
+     */
+    template <int dim>
+    void
+    load_triangulation(Triangulation<dim> &triangulation);
+
+    /**
+     * @brief load_dof_numbering Renumbers the distributed DoFs of
+     *        @p dof_handler according to the restart file, which replaces the
+     *        renumbering of the DoFs in the setup
+     */
+    template <int dim>
+    void
+    load_dof_numbering(DoFHandler<dim> &dof_handler);
+
+    /**
+     * @brief load_vectors Reads the vectors @p vectors, which need to have the
+     *        same size as the saved vectors
+     */
+    template <typename VectorType>
+    void
+    load_vectors(const std::vector<VectorType *> &vectors);
+
+  private:
+    std::ifstream                                    input;
+    std::unique_ptr<boost::archive::binary_iarchive> archive;
+  };
+
+
+
+  inline CheckpointOut::CheckpointOut()
+    : archive(std::make_unique<boost::archive::binary_oarchive>(buffer))
+  {
+    *archive << internal::checkpoint_header;
+  }
+
+
+
+  template <typename T>
+  void
+  CheckpointOut::save(const T &data)
+  {
+    *archive << data;
+  }
+
+
+
+  template <int dim>
+  void
+  CheckpointOut::save_dof_numbering(const DoFHandler<dim> &dof_handler)
+  {
+    std::vector<types::global_dof_index> dof_indices;
+    dof_indices.reserve(dof_handler.n_dofs());
+
+    std::vector<types::global_dof_index> local_dof_indices(
+      dof_handler.get_fe().dofs_per_cell);
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        cell->get_dof_indices(local_dof_indices);
+        dof_indices.insert(dof_indices.end(),
+                           local_dof_indices.begin(),
+                           local_dof_indices.end());
+      }
+
+    const types::global_dof_index n_dofs = dof_handler.n_dofs();
+    *archive << n_dofs << dof_indices;
+  }
+
+
+
+  template <typename VectorType>
+  void
+  CheckpointOut::save_vectors(const std::vector<VectorType *> &vectors)
+  {
+    const unsigned int n_vectors = vectors.size();
+    *archive << n_vectors;
+    for (const VectorType *vector : vectors)
+      internal::save_vector(*archive, *vector);
+  }
+
+
+
+  inline void
+  CheckpointOut::write(const std::string &filename) const
+  {
+    const std::string tmp_filename = filename + ".tmp";
+    {
+      std::ofstream output(tmp_filename, std::ios::binary);
+      AssertThrow(output, ExcIO());
+      const std::string data = buffer.str();
+      output.write(data.data(), data.size());
+      AssertThrow(output, ExcIO());
+    }
+    AssertThrow(std::rename(tmp_filename.c_str(), filename.c_str()) == 0,
+                ExcMessage("Could not replace the restart file " + filename));
+  }
+
+
+
+  inline CheckpointIn::CheckpointIn(const std::string &filename)
+    : input(filename, std::ios::binary)
+  {
+    AssertThrow(input, ExcFileNotOpen(filename));
+    archive = std::make_unique<boost::archive::binary_iarchive>(input);
+
+    std::string header;
+    *archive >> header;
+    AssertThrow(header == internal::checkpoint_header,
+                ExcMessage(filename + " is not a valid restart file"));
+  }
+
+
+
+  template <typename T>
+  void
+  CheckpointIn::load(T &data)
+  {
+    *archive >> data;
+  }
+
+
+
+  template <int dim>
+  void
+  CheckpointIn::load_triangulation(Triangulation<dim> &triangulation)
+  {
+    // Loading clears the triangulation, which is not allowed as long as a
+    // DoFHandler is attached. Hence, the data is copied from a temporary
+    // triangulation
+    Triangulation<dim> restart_triangulation;
+    *archive >> restart_triangulation;
+    triangulation.copy_triangulation(restart_triangulation);
+  }
+
+
+
+  template <int dim>
+  void
+  CheckpointIn::load_dof_numbering(DoFHandler<dim> &dof_handler)
+  {
+    types::global_dof_index              n_dofs;
+    std::vector<types::global_dof_index> dof_indices;
+    *archive >> n_dofs >> dof_indices;
+
+    const std::string error_message =
+      "The DoFs in the restart file do not match the discretization";
+    AssertThrow(n_dofs == dof_handler.n_dofs(), ExcMessage(error_message));
+
+    // Map the current numbering of each cell to the stored one
+    std::vector<types::global_dof_index> new_numbers(
+      n_dofs, numbers::invalid_dof_index);
+    std::vector<types::global_dof_index> local_dof_indices(
+      dof_handler.get_fe().dofs_per_cell);
+
+    unsigned int index = 0;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        cell->get_dof_indices(local_dof_indices);
+        for (const auto dof : local_dof_indices)
+          {
+            AssertThrow(index < dof_indices.size(), ExcMessage(error_message));
+            AssertThrow(new_numbers[dof] == numbers::invalid_dof_index ||
+                          new_numbers[dof] == dof_indices[index],
+                        ExcMessage(error_message));
+            new_numbers[dof] = dof_indices[index++];
+          }
+      }
+    AssertThrow(index == dof_indices.size(), ExcMessage(error_message));
+
+    dof_handler.renumber_dofs(new_numbers);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  CheckpointIn::load_vectors(const std::vector<VectorType *> &vectors)
+  {
+    unsigned int n_vectors;
+    *archive >> n_vectors;
+    AssertThrow(n_vectors == vectors.size(),
+                ExcMessage("The number of vectors in the restart file does not "
+                           "match the solver configuration"));
+    for (VectorType *vector : vectors)
+      internal::load_vector(*archive, *vector);
+  }
+} // namespace Adapter
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,110 @@
+#ifndef COLORED_ASSEMBLY_H
+#define COLORED_ASSEMBLY_H
+
+#include <deal.II/base/graph_coloring.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief make_colored_cells Partitions the active cells of a DoFHandler into
+   *        colors, such that no two cells of the same color write into the
+   *        same global row. The result can be passed to the WorkStream::run()
+   *        overload taking colored iterators, which then executes the worker
+   *        and the copier of all cells of one color concurrently without any
+   *        locking.
+   *
+   *        Two cells conflict, if they share a degree of freedom. Since
+   *        AffineConstraints::distribute_local_to_global() also writes into
+   *        the rows of the master DoFs of constrained entries, these are
+   *        added to the conflict indices of a cell as well.
+   *
+   *        The coloring only depends on the DoF connectivity and needs to be
+   *        recomputed only if the DoFs or the constraint structure change.
+   *
+   * @param[in]  dof_handler DoFHandler to be colored
+   * @param[in]  constraints Constraints used during the scatter
+   *
+   * @return     Cell iterators sorted by color
+   */
+  template <int dim>
+  std::vector<std::vector<typename DoFHandler<dim>::active_cell_iterator>>
+  make_colored_cells(const DoFHandler<dim> &          dof_handler,
+                     const AffineConstraints<double> &constraints)
+  {
+    using CellIterator = typename DoFHandler<dim>::active_cell_iterator;
+
+    const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+
+    const auto get_conflict_indices = [&](const CellIterator &cell) {
+      std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+      cell->get_dof_indices(local_dof_indices);
+
+      std::vector<types::global_dof_index> conflict_indices(local_dof_indices);
+      for (const auto index : local_dof_indices)
+        if (constraints.is_constrained(index))
+          {
+            const auto *entries = constraints.get_constraint_entries(index);
+            if (entries != nullptr)
+              for (const auto &entry : *entries)
+                conflict_indices.push_back(entry.first);
+          }
+
+      std::sort(conflict_indices.begin(), conflict_indices.end());
+      conflict_indices.erase(std::unique(conflict_indices.begin(),
+                                         conflict_indices.end()),
+                             conflict_indices.end());
+      return conflict_indices;
+    };
+
+    return GraphColoring::make_graph_coloring(
+      dof_handler.begin_active(),
+      dof_handler.end(),
+      std::function<std::vector<types::global_dof_index>(
+        const CellIterator &)>(get_conflict_indices));
+  }
+
+
+
+  /**
+   * @brief sort_colored_cells Sorts the cells within each color in the order
+   *        of @p cell_order, e.g., along a space filling curve. The tasks of
+   *        one color then work on cells, which are close to each other, and
+   *        scatter into nearby rows.
+   *
+   * @param[in,out] colored_cells Cells sorted by color
+   * @param[in]     cell_order All active cells in the desired order
+   */
+  template <typename CellIterator>
+  void
+  sort_colored_cells(std::vector<std::vector<CellIterator>> &colored_cells,
+                     const std::vector<CellIterator> &       cell_order)
+  {
+    std::vector<unsigned int> position(cell_order.size());
+    for (unsigned int i = 0; i < cell_order.size(); ++i)
+      {
+        AssertIndexRange(cell_order[i]->active_cell_index(), position.size());
+        position[cell_order[i]->active_cell_index()] = i;
+      }
+
+    for (auto &color : colored_cells)
+      std::sort(color.begin(),
+                color.end(),
+                [&position](const CellIterator &a, const CellIterator &b) {
+                  return position[a->active_cell_index()] <
+                         position[b->active_cell_index()];
+                });
+  }
+} // namespace Adapter
+
+#endif // COLORED_ASSEMBLY_H
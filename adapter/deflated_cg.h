@@ -0,0 +1,351 @@
+#ifndef DEFLATED_CG_H
+#define DEFLATED_CG_H
+
+#include <deal.II/base/exceptions.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief The DeflatedCG class implements a preconditioned conjugate gradient
+   *        method with deflation (Saad et al., 2000) for sequences of linear
+   *        systems with the same or slowly varying matrices.
+   *
+   *        The deflation space W is recycled from previous solves: the
+   *        converged solutions are orthonormalized and kept in a basis of
+   *        limited size, the oldest vectors being dropped first. For thin
+   *        structures, the solutions are dominated by the slow bending modes,
+   *        i.e., the eigenvectors of the smallest eigenvalues, which stall
+   *        the convergence of a CG with a local preconditioner such as SSOR.
+   *        The iterations are restricted to the A-orthogonal complement of W,
+   *        while the component in W is computed by a small dense coarse
+   *        solve with E = W^T A W.
+   *
+   *        Optionally, the initial guess is extrapolated linearly from the
+   *        last two solutions, which suits time stepping schemes.
+   */
+  class DeflatedCG
+  {
+  public:
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  max_basis_size Maximum number of vectors of the deflation
+     *             space
+     * @param[in]  extrapolate_initial_guess Use 2 x_{n-1} - x_{n-2} of the
+     *             previous solves as initial guess
+     */
+    DeflatedCG(const unsigned int max_basis_size,
+               const bool         extrapolate_initial_guess);
+
+    /**
+     * @brief solve Solves the system A x = b. The solution is added to the
+     *        deflation space afterwards.
+     *
+     * @param[in]     A System matrix, which needs to be symmetric positive
+     *                definite
+     * @param[in,out] x Initial guess and solution. The initial guess is
+     *                ignored, if it is extrapolated
+     * @param[in]     b Right-hand side
+     * @param[in]     preconditioner Symmetric positive definite preconditioner
+     * @param[in]     solver_control Convergence criterion
+     */
+    template <typename MatrixType, typename PreconditionerType>
+    void
+    solve(const MatrixType &        A,
+          Vector<double> &          x,
+          const Vector<double> &    b,
+          const PreconditionerType &preconditioner,
+          SolverControl &           solver_control);
+
+    /**
+     * @brief reset_operator Needs to be called, if the matrix changed since
+     *        the last solve. The deflation space is kept, but its image and
+     *        the coarse matrix are recomputed in the next solve.
+     */
+    void
+    reset_operator();
+
+    /**
+     * @brief clear Deletes the deflation space and the stored solutions
+     */
+    void
+    clear();
+
+    /**
+     * @brief size Returns the current number of deflation vectors
+     */
+    unsigned int
+    size() const
+    {
+      return basis.size();
+    }
+
+  private:
+    // Recomputes the image A W of the deflation space and the inverse coarse
+    // matrix
+    template <typename MatrixType>
+    void
+    update_coarse_operator(const MatrixType &A);
+
+    // Computes the inverse of the coarse matrix E = W^T A W
+    void
+    compute_coarse_inverse();
+
+    // Computes W E^{-1} V^T v and adds it with the given factor to dst, where
+    // V is either W or A W
+    void
+    add_coarse_correction(Vector<double> &                   dst,
+                          const double                       factor,
+                          const std::vector<Vector<double>> &V,
+                          const Vector<double> &             v) const;
+
+    // Orthonormalizes a new solution against the deflation space and adds it
+    template <typename MatrixType>
+    void
+    add_to_basis(const MatrixType &A, const Vector<double> &x);
+
+    const unsigned int max_basis_size;
+    const bool         extrapolate_initial_guess;
+
+    // Deflation space W (orthonormal), its image A W and E^{-1}
+    std::vector<Vector<double>> basis;
+    std::vector<Vector<double>> basis_image;
+    FullMatrix<double>          coarse_inverse;
+    bool                        operator_changed;
+
+    // The last two solutions for the extrapolation
+    Vector<double> last_solution;
+    Vector<double> second_last_solution;
+    unsigned int   n_solutions;
+  };
+
+
+
+  inline DeflatedCG::DeflatedCG(const unsigned int max_basis_size,
+                                const bool         extrapolate_initial_guess)
+    : max_basis_size(max_basis_size)
+    , extrapolate_initial_guess(extrapolate_initial_guess)
+    , operator_changed(true)
+    , n_solutions(0)
+  {}
+
+
+
+  inline void
+  DeflatedCG::reset_operator()
+  {
+    operator_changed = true;
+  }
+
+
+
+  inline void
+  DeflatedCG::clear()
+  {
+    basis.clear();
+    basis_image.clear();
+    coarse_inverse.reinit(0, 0);
+    operator_changed = true;
+    n_solutions      = 0;
+  }
+
+
+
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  DeflatedCG::solve(const MatrixType &        A,
+                    Vector<double> &          x,
+                    const Vector<double> &    b,
+                    const PreconditionerType &preconditioner,
+                    SolverControl &           solver_control)
+  {
+    AssertDimension(x.size(), b.size());
+
+    // The sizes change, if the system has been set up again
+    if (!basis.empty() && basis[0].size() != b.size())
+      clear();
+    if (n_solutions > 0 && last_solution.size() != b.size())
+      n_solutions = 0;
+
+    if (operator_changed)
+      update_coarse_operator(A);
+
+    if (extrapolate_initial_guess && n_solutions == 1)
+      x = last_solution;
+    else if (extrapolate_initial_guess && n_solutions > 1)
+      {
+        x.equ(2., last_solution);
+        x.add(-1., second_last_solution);
+      }
+
+    // Initial residual, which is made orthogonal to W by a coarse correction
+    // of the initial guess
+    Vector<double> r(b.size());
+    A.vmult(r, x);
+    r.sadd(-1., 1., b);
+
+    if (!basis.empty())
+      {
+        Vector<double> correction(b.size());
+        add_coarse_correction(correction, 1., basis, r);
+        x += correction;
+
+        Vector<double> tmp(b.size());
+        A.vmult(tmp, correction);
+        r -= tmp;
+      }
+
+    Vector<double> z(b.size());
+    Vector<double> p(b.size());
+    Vector<double> Ap(b.size());
+
+    unsigned int iteration = 0;
+
+    SolverControl::State state = solver_control.check(iteration, r.l2_norm());
+
+    if (state == SolverControl::iterate)
+      {
+        preconditioner.vmult(z, r);
+        p = z;
+        add_coarse_correction(p, -1., basis_image, z);
+      }
+
+    double rz = r * z;
+    while (state == SolverControl::iterate)
+      {
+        A.vmult(Ap, p);
+        const double alpha = rz / (p * Ap);
+
+        x.add(alpha, p);
+        r.add(-alpha, Ap);
+
+        preconditioner.vmult(z, r);
+        const double rz_new = r * z;
+        const double beta   = rz_new / rz;
+        rz                  = rz_new;
+
+        // p = z + beta p - W E^{-1} (A W)^T z
+        p.sadd(beta, 1., z);
+        add_coarse_correction(p, -1., basis_image, z);
+
+        ++iteration;
+        state = solver_control.check(iteration, r.l2_norm());
+      }
+
+    AssertThrow(state == SolverControl::success,
+                SolverControl::NoConvergence(solver_control.last_step(),
+                                             solver_control.last_value()));
+
+    add_to_basis(A, x);
+
+    second_last_solution = last_solution;
+    last_solution        = x;
+    ++n_solutions;
+  }
+
+
+
+  template <typename MatrixType>
+  void
+  DeflatedCG::update_coarse_operator(const MatrixType &A)
+  {
+    const unsigned int n_vectors = basis.size();
+
+    basis_image.resize(n_vectors);
+    for (unsigned int i = 0; i < n_vectors; ++i)
+      {
+        basis_image[i].reinit(basis[i].size());
+        A.vmult(basis_image[i], basis[i]);
+      }
+
+    compute_coarse_inverse();
+    operator_changed = false;
+  }
+
+
+
+  inline void
+  DeflatedCG::compute_coarse_inverse()
+  {
+    const unsigned int n_vectors = basis.size();
+
+    coarse_inverse.reinit(n_vectors, n_vectors);
+    for (unsigned int i = 0; i < n_vectors; ++i)
+      for (unsigned int j = 0; j < n_vectors; ++j)
+        coarse_inverse(i, j) = basis[i] * basis_image[j];
+
+    if (n_vectors > 0)
+      coarse_inverse.gauss_jordan();
+  }
+
+
+
+  inline void
+  DeflatedCG::add_coarse_correction(Vector<double> &                   dst,
+                                    const double                       factor,
+                                    const std::vector<Vector<double>> &V,
+                                    const Vector<double> &             v) const
+  {
+    const unsigned int n_vectors = basis.size();
+    if (n_vectors == 0)
+      return;
+
+    Vector<double> projection(n_vectors);
+    for (unsigned int i = 0; i < n_vectors; ++i)
+      projection(i) = V[i] * v;
+
+    Vector<double> coefficients(n_vectors);
+    coarse_inverse.vmult(coefficients, projection);
+
+    for (unsigned int i = 0; i < n_vectors; ++i)
+      dst.add(factor * coefficients(i), basis[i]);
+  }
+
+
+
+  template <typename MatrixType>
+  void
+  DeflatedCG::add_to_basis(const MatrixType &A, const Vector<double> &x)
+  {
+    if (max_basis_size == 0)
+      return;
+
+    const double norm = x.l2_norm();
+    if (norm == 0.)
+      return;
+
+    // Classical Gram-Schmidt, applied twice for stability
+    Vector<double> w(x);
+    for (unsigned int pass = 0; pass < 2; ++pass)
+      for (const auto &vector : basis)
+        w.add(-(vector * w), vector);
+
+    // Skip solutions, which are (almost) contained in the deflation space
+    const double new_norm = w.l2_norm();
+    if (new_norm < 1e-8 * norm)
+      return;
+    w /= new_norm;
+
+    if (basis.size() == max_basis_size)
+      {
+        basis.erase(basis.begin());
+        basis_image.erase(basis_image.begin());
+      }
+
+    basis.push_back(w);
+    basis_image.emplace_back(w.size());
+    A.vmult(basis_image.back(), w);
+
+    compute_coarse_inverse();
+  }
+} // namespace Adapter
+
+#endif // DEFLATED_CG_H
@@ -0,0 +1,152 @@
+#ifndef DOF_RENUMBERING_H
+#define DOF_RENUMBERING_H
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief hilbert_cell_order Sorts the active cells of @p dof_handler along
+   *        a Hilbert curve through the cell centers
+   *
+   * @param[in]  dof_handler DoFHandler, whose cells are sorted
+   *
+   * @return     All active cells in the order of the curve
+   */
+  template <int dim>
+  std::vector<typename DoFHandler<dim>::active_cell_iterator>
+  hilbert_cell_order(const DoFHandler<dim> &dof_handler)
+  {
+    using CellIterator = typename DoFHandler<dim>::active_cell_iterator;
+
+    std::vector<CellIterator> cells;
+    std::vector<Point<dim>>   centers;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        cells.push_back(cell);
+        centers.push_back(cell->center());
+      }
+
+    // The centers are mapped to the bounding box internally. All coordinates
+    // of a cell have to fit into a single 64 bit key
+    const int  bits_per_dim = 64 / dim;
+    const auto indices =
+      Utilities::inverse_Hilbert_space_filling_curve(centers, bits_per_dim);
+
+    std::vector<std::pair<std::uint64_t, unsigned int>> keys(cells.size());
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      keys[c] = {Utilities::pack_integers<dim>(indices[c], bits_per_dim), c};
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<CellIterator> ordered_cells(cells.size());
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      ordered_cells[c] = cells[keys[c].second];
+
+    return ordered_cells;
+  }
+
+
+
+  /**
+   * @brief renumber_dofs Renumbers the DoFs of @p dof_handler in order to
+   *        improve the memory locality of the sparse matrix operations and to
+   *        reduce the fill-in of the direct solvers. The following strategies
+   *        are available:
+   *
+   *        - None: the order of distribute_dofs(), i.e., the components are
+   *          interleaved and the cells are traversed in creation order
+   *        - Cuthill-McKee: bandwidth reduction on the DoF graph
+   *        - Hilbert: the cells are sorted along a Hilbert curve through the
+   *          cell centers and the DoFs are numbered cell by cell, with
+   *          interleaved components
+   *        - Component-wise: the components are blocked, each block being
+   *          numbered by Cuthill-McKee
+   *
+   *        Only the DoF numbering changes. In order to traverse the cells in
+   *        the same order as the DoFs, e.g., during the assembly, use
+   *        hilbert_cell_order().
+   *
+   * @param[in]  dof_handler DoFHandler with distributed DoFs
+   * @param[in]  strategy One of the strategies above
+   */
+  template <int dim>
+  void
+  renumber_dofs(DoFHandler<dim> &dof_handler, const std::string &strategy)
+  {
+    if (strategy == "Cuthill-McKee")
+      DoFRenumbering::Cuthill_McKee(dof_handler);
+    else if (strategy == "Hilbert")
+      DoFRenumbering::cell_wise(dof_handler, hilbert_cell_order(dof_handler));
+    else if (strategy == "Component-wise")
+      {
+        // component_wise() keeps the relative order within each component
+        DoFRenumbering::Cuthill_McKee(dof_handler);
+        DoFRenumbering::component_wise(dof_handler);
+      }
+    else
+      AssertThrow(strategy == "None",
+                  ExcMessage("Unknown DoF renumbering " + strategy));
+  }
+
+
+
+  /**
+   * @brief print_matrix_layout Prints the bandwidth and the number of nonzero
+   *        entries of @p matrix and measures the throughput of the sparse
+   *        matrix-vector product, in order to compare the DoF renumberings.
+   *
+   * @param[in]  matrix Matrix to be analyzed
+   * @param[in]  n_repetitions Number of timed matrix-vector products
+   */
+  inline void
+  print_matrix_layout(const SparseMatrix<double> &matrix,
+                      const unsigned int          n_repetitions = 20)
+  {
+    Vector<double> src(matrix.n());
+    Vector<double> dst(matrix.m());
+    src = 1.;
+
+    // Warm up, such that the first touch of dst is not measured
+    matrix.vmult(dst, src);
+
+    Timer timer;
+    for (unsigned int i = 0; i < n_repetitions; ++i)
+      matrix.vmult(dst, src);
+    timer.stop();
+
+    const double time_per_product = timer.wall_time() / n_repetitions;
+
+    // A product loads each entry (8 bytes) and its column index (4 bytes) and
+    // performs two floating point operations per entry
+    const double n_entries = matrix.n_nonzero_elements();
+
+    std::cout << "Matrix layout:"
+              << "\n\t Bandwidth: " << matrix.get_sparsity_pattern().bandwidth()
+              << "\n\t Nonzero entries: " << matrix.n_nonzero_elements()
+              << "\n\t SpMV time: " << time_per_product * 1e3 << " ms"
+              << "\n\t SpMV throughput: "
+              << 2. * n_entries / time_per_product * 1e-9 << " GFlop/s, "
+              << 12. * n_entries / time_per_product * 1e-9 << " GB/s"
+              << std::endl;
+  }
+} // namespace Adapter
+
+#endif // DOF_RENUMBERING_H
@@ -0,0 +1,162 @@
+#ifndef INTERFACE_OUTPUT_H
+#define INTERFACE_OUTPUT_H
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out_faces.h>
+
+#include <functional>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief The InterfaceDataOutFaces class restricts the output of
+   *        DataOutFaces to the boundary faces with the given boundary ID,
+   *        e.g., the coupling interface. The surface output is much smaller
+   *        than the volume output and can, hence, be written more often.
+   */
+  template <int dim>
+  class InterfaceDataOutFaces : public DataOutFaces<dim>
+  {
+  public:
+    using FaceDescriptor = typename DataOutFaces<dim>::FaceDescriptor;
+
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  boundary_id Boundary ID of the faces to be written
+     */
+    InterfaceDataOutFaces(const types::boundary_id boundary_id)
+      : DataOutFaces<dim>(/*surface_only = */ true)
+      , boundary_id(boundary_id)
+    {}
+
+    virtual FaceDescriptor
+    first_face() override
+    {
+      for (const auto &cell : this->triangulation->active_cell_iterators())
+        for (const unsigned int face : GeometryInfo<dim>::face_indices())
+          if (is_interface_face(cell, face))
+            return FaceDescriptor(cell, face);
+
+      return FaceDescriptor(this->triangulation->end(), 0);
+    }
+
+    virtual FaceDescriptor
+    next_face(const FaceDescriptor &face) override
+    {
+      // Remaining faces of the current cell
+      for (unsigned int f = face.second + 1;
+           f < GeometryInfo<dim>::faces_per_cell;
+           ++f)
+        if (is_interface_face(face.first, f))
+          return FaceDescriptor(face.first, f);
+
+      // Faces of the following cells
+      typename Triangulation<dim>::active_cell_iterator cell = face.first;
+      for (++cell; cell != this->triangulation->end(); ++cell)
+        for (const unsigned int f : GeometryInfo<dim>::face_indices())
+          if (is_interface_face(cell, f))
+            return FaceDescriptor(cell, f);
+
+      return FaceDescriptor(this->triangulation->end(), 0);
+    }
+
+  private:
+    template <typename CellIterator>
+    bool
+    is_interface_face(const CellIterator &cell, const unsigned int face) const
+    {
+      return cell->face(face)->at_boundary() &&
+             cell->face(face)->boundary_id() == boundary_id;
+    }
+
+    const types::boundary_id boundary_id;
+  };
+
+
+
+  /**
+   * @brief project_interface_data Converts data given at the quadrature
+   *        points of the interface faces, e.g., the coupling data received
+   *        from preCICE, into a finite element field by a lumped L2
+   *        projection. The field is only meant for visualization.
+   *
+   * @param[in]  dof_handler DoFHandler of a vector valued element with dim
+   *             components
+   * @param[in]  mapping Mapping of the reference configuration
+   * @param[in]  quadrature Face quadrature of the data points
+   * @param[in]  boundary_id Boundary ID of the interface faces
+   * @param[in]  data Returns the value of a data point, which are numbered
+   *             consecutively in the order of the interface faces of the
+   *             active cells and their quadrature points
+   * @param[out] result Projected field, which is zero away from the interface
+   */
+  template <int dim>
+  void
+  project_interface_data(
+    const DoFHandler<dim> &                                   dof_handler,
+    const Mapping<dim> &                                      mapping,
+    const Quadrature<dim - 1> &                               quadrature,
+    const types::boundary_id                                  boundary_id,
+    const std::function<Tensor<1, dim>(const unsigned int)> &data,
+    Vector<double> &                                          result)
+  {
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    AssertDimension(fe.n_components(), dim);
+
+    FEFaceValues<dim> fe_face_values(mapping,
+                                     fe,
+                                     quadrature,
+                                     update_values | update_JxW_values);
+
+    const unsigned int                   dofs_per_cell = fe.dofs_per_cell;
+    std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+
+    Vector<double> weights(dof_handler.n_dofs());
+    result.reinit(dof_handler.n_dofs());
+
+    unsigned int point = 0;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      for (const auto &face : cell->face_iterators())
+        if (face->at_boundary() == true && face->boundary_id() == boundary_id)
+          {
+            fe_face_values.reinit(cell, face);
+            cell->get_dof_indices(local_dof_indices);
+
+            for (const auto q : fe_face_values.quadrature_point_indices())
+              {
+                const Tensor<1, dim> value = data(point++);
+                for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                  {
+                    const unsigned int component =
+                      fe.system_to_component_index(i).first;
+                    const double weight = fe_face_values.shape_value(i, q) *
+                                          fe_face_values.JxW(q);
+
+                    result(local_dof_indices[i]) += weight * value[component];
+                    weights(local_dof_indices[i]) += weight;
+                  }
+              }
+          }
+
+    for (unsigned int i = 0; i < result.size(); ++i)
+      if (weights(i) != 0.)
+        result(i) /= weights(i);
+  }
+} // namespace Adapter
+
+#endif // INTERFACE_OUTPUT_H
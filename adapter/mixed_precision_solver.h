@@ -0,0 +1,153 @@
+#ifndef MIXED_PRECISION_SOLVER_H
+#define MIXED_PRECISION_SOLVER_H
+
+#include <deal.II/base/exceptions.h>
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief The MixedPrecisionSolver class solves symmetric positive definite
+   *        systems by iterative refinement: the residual and the solution are
+   *        computed in double precision, whereas the corrections are computed
+   *        by an SSOR preconditioned CG on a single precision copy of the
+   *        matrix. Since the CG iterations are bound by the memory bandwidth,
+   *        reading floats instead of doubles reduces the matrix traffic from
+   *        12 to 8 bytes per entry (value and column index). The outer loop
+   *        restores the accuracy of a double precision solve, as long as the
+   *        condition number of the matrix is well below the inverse of the
+   *        single precision round-off (about 1e7).
+   *
+   *        The solver trades memory for bandwidth: the single precision copy
+   *        is kept in addition to the double precision matrix, which shares
+   *        its sparsity pattern, so that the matrix storage grows by 4 bytes
+   *        per entry. The double precision matrix is not dropped: it
+   *        provides the residual of the outer loop, the solvers assemble into
+   *        it and the linear elasticity solver forms its right-hand side with
+   *        it.
+   */
+  class MixedPrecisionSolver
+  {
+  public:
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  inner_tolerance Relative reduction of the residual in each
+     *             single precision solve
+     */
+    MixedPrecisionSolver(const double inner_tolerance = 1e-4);
+
+    /**
+     * @brief initialize Copies @p matrix to single precision and sets up the
+     *        SSOR preconditioner with the relaxation parameter @p relaxation
+     */
+    void
+    initialize(const SparseMatrix<double> &matrix, const double relaxation);
+
+    /**
+     * @brief solve Solves the system @p matrix x = b. The convergence is
+     *        checked by @p solver_control in terms of the double precision
+     *        residual, the number of steps being the total number of inner CG
+     *        iterations.
+     */
+    void
+    solve(const SparseMatrix<double> &matrix,
+          Vector<double> &            x,
+          const Vector<double> &      b,
+          SolverControl &             solver_control) const;
+
+  private:
+    const double inner_tolerance;
+
+    SparseMatrix<float>                   matrix_float;
+    PreconditionSSOR<SparseMatrix<float>> preconditioner;
+  };
+
+
+
+  inline
+  MixedPrecisionSolver::MixedPrecisionSolver(const double inner_tolerance)
+    : inner_tolerance(inner_tolerance)
+  {}
+
+
+
+  inline void
+  MixedPrecisionSolver::initialize(const SparseMatrix<double> &matrix,
+                                   const double                relaxation)
+  {
+    if (matrix_float.empty() ||
+        &matrix_float.get_sparsity_pattern() != &matrix.get_sparsity_pattern())
+      matrix_float.reinit(matrix.get_sparsity_pattern());
+
+    matrix_float.copy_from(matrix);
+    preconditioner.initialize(matrix_float, relaxation);
+  }
+
+
+
+  inline void
+  MixedPrecisionSolver::solve(const SparseMatrix<double> &matrix,
+                              Vector<double> &            x,
+                              const Vector<double> &      b,
+                              SolverControl &             solver_control) const
+  {
+    Vector<double> residual(b.size());
+    Vector<float>  residual_float(b.size());
+    Vector<float>  correction_float(b.size());
+    Vector<double> correction(b.size());
+
+    unsigned int n_inner_iterations = 0;
+    double       residual_norm      = matrix.residual(residual, x, b);
+
+    SolverControl::State state =
+      solver_control.check(n_inner_iterations, residual_norm);
+
+    while (state == SolverControl::iterate)
+      {
+        residual_float   = residual;
+        correction_float = 0.f;
+
+        // An inexact correction is sufficient, so that the inner solver is
+        // not required to converge
+        SolverControl inner_control(solver_control.max_steps() -
+                                      n_inner_iterations,
+                                    inner_tolerance * residual_norm,
+                                    false,
+                                    false);
+        SolverCG<Vector<float>> solver_CG(inner_control);
+        try
+          {
+            solver_CG.solve(matrix_float,
+                            correction_float,
+                            residual_float,
+                            preconditioner);
+          }
+        catch (const SolverControl::NoConvergence &)
+          {}
+
+        n_inner_iterations += std::max(inner_control.last_step(), 1u);
+
+        correction = correction_float;
+        x += correction;
+
+        residual_norm = matrix.residual(residual, x, b);
+        state = solver_control.check(n_inner_iterations, residual_norm);
+      }
+
+    AssertThrow(state == SolverControl::success,
+                SolverControl::NoConvergence(solver_control.last_step(),
+                                             solver_control.last_value()));
+  }
+} // namespace Adapter
+
+#endif // MIXED_PRECISION_SOLVER_H
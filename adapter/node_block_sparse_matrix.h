@@ -0,0 +1,524 @@
+#ifndef NODE_BLOCK_SPARSE_MATRIX_H
+#define NODE_BLOCK_SPARSE_MATRIX_H
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief make_node_contiguous Renumbers the DoFs of a vector-valued
+   *        FESystem with dim components, such that the dim DoFs of each
+   *        support point (node) are contiguous, i.e., DoF dim * I + c is the
+   *        component c of node I. The nodes keep the relative order of
+   *        their smallest DoF index, so that a preceding renumbering (e.g.
+   *        Cuthill-McKee) carries over to the nodes. This numbering is
+   *        required by the NodeBlockSparseMatrix.
+   *
+   * @param[in]  dof_handler DoFHandler with distributed DoFs
+   */
+  template <int dim>
+  void
+  make_node_contiguous(DoFHandler<dim> &dof_handler)
+  {
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    AssertThrow(fe.n_base_elements() == 1 && fe.element_multiplicity(0) == dim,
+                ExcMessage("The node blocked format requires an FESystem "
+                           "with dim copies of a scalar element"));
+
+    const unsigned int dofs_per_cell      = fe.dofs_per_cell;
+    const unsigned int base_dofs_per_cell = fe.base_element(0).dofs_per_cell;
+
+    // The node of a DoF is represented by the smallest DoF index of the node
+    std::vector<types::global_dof_index> node_of_dof(dof_handler.n_dofs());
+    std::vector<unsigned int>            component_of_dof(dof_handler.n_dofs());
+
+    std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+    std::vector<types::global_dof_index> cell_nodes(base_dofs_per_cell);
+
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        cell->get_dof_indices(local_dof_indices);
+
+        std::fill(cell_nodes.begin(),
+                  cell_nodes.end(),
+                  numbers::invalid_dof_index);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            const unsigned int base = fe.system_to_component_index(i).second;
+            cell_nodes[base] = std::min(cell_nodes[base], local_dof_indices[i]);
+          }
+
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            const auto component_base = fe.system_to_component_index(i);
+            node_of_dof[local_dof_indices[i]] =
+              cell_nodes[component_base.second];
+            component_of_dof[local_dof_indices[i]] = component_base.first;
+          }
+      }
+
+    std::vector<std::tuple<types::global_dof_index,
+                           unsigned int,
+                           types::global_dof_index>>
+      sorted_dofs(dof_handler.n_dofs());
+    for (types::global_dof_index i = 0; i < dof_handler.n_dofs(); ++i)
+      sorted_dofs[i] = std::make_tuple(node_of_dof[i], component_of_dof[i], i);
+    std::sort(sorted_dofs.begin(), sorted_dofs.end());
+
+    std::vector<types::global_dof_index> new_numbers(dof_handler.n_dofs());
+    for (types::global_dof_index i = 0; i < dof_handler.n_dofs(); ++i)
+      new_numbers[std::get<2>(sorted_dofs[i])] = i;
+
+    dof_handler.renumber_dofs(new_numbers);
+  }
+
+
+
+  /**
+   * @brief The NodeBlockSparseMatrix class stores a sparse matrix of a
+   *        vector-valued problem in block compressed row format (BSR): each
+   *        entry of the sparsity pattern couples two nodes and holds a dense
+   *        dim x dim block. Compared to the scalar format of SparseMatrix, a
+   *        column index is stored once per block instead of once per entry,
+   *        which reduces the index traffic of the matrix-vector product and
+   *        the smoothers.
+   *
+   *        The matrix is filled by copying an assembled SparseMatrix, so that
+   *        the usual assembly via distribute_local_to_global() is kept. The
+   *        DoFs need to be numbered node by node (see make_node_contiguous()).
+   *
+   *        The fixed block size lets the compiler unroll and vectorize the
+   *        block operations.
+   */
+  template <int dim>
+  class NodeBlockSparseMatrix : public Subscriptor
+  {
+  public:
+    static constexpr unsigned int block_size = dim * dim;
+
+    NodeBlockSparseMatrix();
+
+    /**
+     * @brief reinit Sets up the block pattern, which covers all entries of
+     *        the scalar @p sparsity_pattern
+     */
+    void
+    reinit(const SparsityPattern &sparsity_pattern);
+
+    /**
+     * @brief copy_from Copies the values of @p matrix, which needs to be
+     *        based on the sparsity pattern passed to @p reinit()
+     */
+    void
+    copy_from(const SparseMatrix<double> &matrix);
+
+    /**
+     * @brief vmult Computes dst = A src
+     */
+    void
+    vmult(Vector<double> &dst, const Vector<double> &src) const;
+
+    /**
+     * @brief precondition_Jacobi Applies the block Jacobi method, i.e.,
+     *        dst = omega D^{-1} src with the inverse diagonal blocks D^{-1}
+     */
+    void
+    precondition_Jacobi(Vector<double> &      dst,
+                        const Vector<double> &src,
+                        const double          omega) const;
+
+    /**
+     * @brief precondition_SSOR Applies the block SSOR method, i.e.,
+     *        dst = M^{-1} src with
+     *        M = 1 / (omega (2 - omega)) (D + omega L) D^{-1} (D + omega U)
+     */
+    void
+    precondition_SSOR(Vector<double> &      dst,
+                      const Vector<double> &src,
+                      const double          omega) const;
+
+    types::global_dof_index
+    m() const
+    {
+      return n_block_rows * dim;
+    }
+
+    types::global_dof_index
+    n() const
+    {
+      return n_block_rows * dim;
+    }
+
+    /**
+     * @brief memory_consumption Returns the memory of all data of the block
+     *        format in bytes, i.e., the values, the block pattern, the
+     *        inverse diagonal blocks and the map from the entries of the
+     *        scalar matrix. The scalar matrix itself is not included.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    // y += B x for a dense block B of the matrix
+    static void
+    add_block_vmult(double *y, const double *block, const double *x);
+
+    void
+    vmult_on_subrange(const unsigned int    begin,
+                      const unsigned int    end,
+                      Vector<double> &      dst,
+                      const Vector<double> &src) const;
+
+    void
+    compute_diagonal_inverses();
+
+    unsigned int n_block_rows;
+
+    // Block pattern and the dense blocks in row-major order
+    std::vector<std::size_t>  row_start;
+    std::vector<unsigned int> column_index;
+    std::vector<std::size_t>  diagonal_block;
+    std::vector<double>       values;
+    std::vector<double>       diagonal_inverses;
+
+    // Position of each entry of the scalar matrix (in storage order) in the
+    // block values
+    const SparsityPattern *  sparsity_pattern;
+    std::vector<std::size_t> entry_position;
+  };
+
+
+
+  /**
+   * @brief The PreconditionNodeBlock class applies the block Jacobi or block
+   *        SSOR method of a NodeBlockSparseMatrix as preconditioner.
+   */
+  template <int dim>
+  class PreconditionNodeBlock : public Subscriptor
+  {
+  public:
+    enum class Type
+    {
+      jacobi,
+      ssor
+    };
+
+    PreconditionNodeBlock()
+      : matrix(nullptr)
+      , type(Type::ssor)
+      , relaxation(1.)
+    {}
+
+    void
+    initialize(const NodeBlockSparseMatrix<dim> &matrix,
+               const Type                        type,
+               const double                      relaxation)
+    {
+      this->matrix     = &matrix;
+      this->type       = type;
+      this->relaxation = relaxation;
+    }
+
+    void
+    vmult(Vector<double> &dst, const Vector<double> &src) const
+    {
+      Assert(matrix != nullptr, ExcNotInitialized());
+      if (type == Type::jacobi)
+        matrix->precondition_Jacobi(dst, src, relaxation);
+      else
+        matrix->precondition_SSOR(dst, src, relaxation);
+    }
+
+  private:
+    const NodeBlockSparseMatrix<dim> *matrix;
+    Type                              type;
+    double                            relaxation;
+  };
+
+
+
+  template <int dim>
+  NodeBlockSparseMatrix<dim>::NodeBlockSparseMatrix()
+    : n_block_rows(0)
+    , sparsity_pattern(nullptr)
+  {}
+
+
+
+  template <int dim>
+  void
+  NodeBlockSparseMatrix<dim>::reinit(const SparsityPattern &sparsity_pattern)
+  {
+    AssertThrow(sparsity_pattern.n_rows() % dim == 0,
+                ExcMessage("The number of rows is no multiple of dim"));
+
+    this->sparsity_pattern = &sparsity_pattern;
+    n_block_rows           = sparsity_pattern.n_rows() / dim;
+
+    // The block columns of a node are the union of the columns of its rows
+    row_start.resize(n_block_rows + 1);
+    column_index.clear();
+    diagonal_block.resize(n_block_rows);
+
+    std::vector<unsigned int> block_columns;
+    row_start[0] = 0;
+    for (unsigned int I = 0; I < n_block_rows; ++I)
+      {
+        block_columns.clear();
+        for (unsigned int c = 0; c < dim; ++c)
+          for (auto entry = sparsity_pattern.begin(dim * I + c);
+               entry != sparsity_pattern.end(dim * I + c);
+               ++entry)
+            block_columns.push_back(entry->column() / dim);
+
+        std::sort(block_columns.begin(), block_columns.end());
+        block_columns.erase(std::unique(block_columns.begin(),
+                                        block_columns.end()),
+                            block_columns.end());
+
+        const auto diagonal =
+          std::lower_bound(block_columns.begin(), block_columns.end(), I);
+        AssertThrow(diagonal != block_columns.end() && *diagonal == I,
+                    ExcMessage("Missing diagonal block"));
+        diagonal_block[I] = row_start[I] + (diagonal - block_columns.begin());
+
+        column_index.insert(column_index.end(),
+                            block_columns.begin(),
+                            block_columns.end());
+        row_start[I + 1] = column_index.size();
+      }
+
+    values.assign(column_index.size() * block_size, 0.);
+    diagonal_inverses.assign(n_block_rows * block_size, 0.);
+
+    // Map the scalar entries to their position in the blocks
+    entry_position.resize(sparsity_pattern.n_nonzero_elements());
+    std::size_t index = 0;
+    for (types::global_dof_index row = 0; row < sparsity_pattern.n_rows();
+         ++row)
+      {
+        const unsigned int I = row / dim;
+        for (auto entry = sparsity_pattern.begin(row);
+             entry != sparsity_pattern.end(row);
+             ++entry, ++index)
+          {
+            const unsigned int J = entry->column() / dim;
+            const std::size_t  block =
+              std::lower_bound(column_index.begin() + row_start[I],
+                               column_index.begin() + row_start[I + 1],
+                               J) -
+              column_index.begin();
+
+            entry_position[index] = block * block_size + (row % dim) * dim +
+                                    entry->column() % dim;
+          }
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  NodeBlockSparseMatrix<dim>::copy_from(const SparseMatrix<double> &matrix)
+  {
+    AssertThrow(&matrix.get_sparsity_pattern() == sparsity_pattern,
+                ExcMessage("The matrix is not based on the sparsity pattern "
+                           "of the block matrix"));
+
+    // Entries of a block, which are not part of the scalar pattern, are zero
+    std::fill(values.begin(), values.end(), 0.);
+
+    std::size_t index = 0;
+    for (auto entry = matrix.begin(); entry != matrix.end(); ++entry, ++index)
+      values[entry_position[index]] = entry->value();
+    AssertDimension(index, entry_position.size());
+
+    compute_diagonal_inverses();
+  }
+
+
+
+  template <int dim>
+  void
+  NodeBlockSparseMatrix<dim>::compute_diagonal_inverses()
+  {
+    for (unsigned int I = 0; I < n_block_rows; ++I)
+      {
+        const double *block = &values[diagonal_block[I] * block_size];
+
+        Tensor<2, dim> diagonal;
+        for (unsigned int i = 0; i < dim; ++i)
+          for (unsigned int j = 0; j < dim; ++j)
+            diagonal[i][j] = block[i * dim + j];
+
+        AssertThrow(determinant(diagonal) != 0.,
+                    ExcMessage("Singular diagonal block"));
+        const Tensor<2, dim> inverse = invert(diagonal);
+
+        double *inverse_block = &diagonal_inverses[I * block_size];
+        for (unsigned int i = 0; i < dim; ++i)
+          for (unsigned int j = 0; j < dim; ++j)
+            inverse_block[i * dim + j] = inverse[i][j];
+      }
+  }
+
+
+
+  template <int dim>
+  inline void
+  NodeBlockSparseMatrix<dim>::add_block_vmult(double *      y,
+                                              const double *block,
+                                              const double *x)
+  {
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        y[i] += block[i * dim + j] * x[j];
+  }
+
+
+
+  template <int dim>
+  void
+  NodeBlockSparseMatrix<dim>::vmult_on_subrange(
+    const unsigned int    begin,
+    const unsigned int    end,
+    Vector<double> &      dst,
+    const Vector<double> &src) const
+  {
+    for (unsigned int I = begin; I < end; ++I)
+      {
+        double y[dim] = {};
+        for (std::size_t b = row_start[I]; b < row_start[I + 1]; ++b)
+          add_block_vmult(y,
+                          &values[b * block_size],
+                          src.begin() + dim * column_index[b]);
+
+        for (unsigned int i = 0; i < dim; ++i)
+          dst[dim * I + i] = y[i];
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  NodeBlockSparseMatrix<dim>::vmult(Vector<double> &      dst,
+                                    const Vector<double> &src) const
+  {
+    AssertDimension(dst.size(), m());
+    AssertDimension(src.size(), n());
+
+    // The block rows are distributed to the threads like the rows of the
+    // scalar SparseMatrix::vmult()
+    parallel::apply_to_subranges(
+      0U,
+      n_block_rows,
+      [&](const unsigned int begin, const unsigned int end) {
+        vmult_on_subrange(begin, end, dst, src);
+      },
+      /*grainsize = */ 256);
+  }
+
+
+
+  template <int dim>
+  void
+  NodeBlockSparseMatrix<dim>::precondition_Jacobi(Vector<double> &      dst,
+                                                  const Vector<double> &src,
+                                                  const double omega) const
+  {
+    AssertDimension(dst.size(), m());
+    AssertDimension(src.size(), n());
+
+    for (unsigned int I = 0; I < n_block_rows; ++I)
+      {
+        double y[dim] = {};
+        add_block_vmult(y,
+                        &diagonal_inverses[I * block_size],
+                        src.begin() + dim * I);
+
+        for (unsigned int i = 0; i < dim; ++i)
+          dst[dim * I + i] = omega * y[i];
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  NodeBlockSparseMatrix<dim>::precondition_SSOR(Vector<double> &      dst,
+                                                const Vector<double> &src,
+                                                const double omega) const
+  {
+    AssertDimension(dst.size(), m());
+    AssertDimension(src.size(), n());
+
+    // Forward sweep: (D + omega L) y = src
+    for (unsigned int I = 0; I < n_block_rows; ++I)
+      {
+        double r[dim] = {};
+        for (std::size_t b = row_start[I]; b < diagonal_block[I]; ++b)
+          add_block_vmult(r,
+                          &values[b * block_size],
+                          dst.begin() + dim * column_index[b]);
+        for (unsigned int i = 0; i < dim; ++i)
+          r[i] = src[dim * I + i] - omega * r[i];
+
+        double y[dim] = {};
+        add_block_vmult(y, &diagonal_inverses[I * block_size], r);
+        for (unsigned int i = 0; i < dim; ++i)
+          dst[dim * I + i] = y[i];
+      }
+
+    // Backward sweep: (D + omega U) x = omega (2 - omega) D y, i.e.,
+    // x = omega (2 - omega) y - omega D^{-1} U x
+    for (unsigned int I = n_block_rows; I-- > 0;)
+      {
+        double r[dim] = {};
+        for (std::size_t b = diagonal_block[I] + 1; b < row_start[I + 1]; ++b)
+          add_block_vmult(r,
+                          &values[b * block_size],
+                          dst.begin() + dim * column_index[b]);
+
+        double y[dim] = {};
+        add_block_vmult(y, &diagonal_inverses[I * block_size], r);
+        for (unsigned int i = 0; i < dim; ++i)
+          dst[dim * I + i] =
+            omega * (2. - omega) * dst[dim * I + i] - omega * y[i];
+      }
+  }
+
+
+
+  template <int dim>
+  std::size_t
+  NodeBlockSparseMatrix<dim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(values) +
+           MemoryConsumption::memory_consumption(diagonal_inverses) +
+           MemoryConsumption::memory_consumption(row_start) +
+           MemoryConsumption::memory_consumption(column_index) +
+           MemoryConsumption::memory_consumption(diagonal_block) +
+           MemoryConsumption::memory_consumption(entry_position);
+  }
+} // namespace Adapter
+
+#endif // NODE_BLOCK_SPARSE_MATRIX_H
@@ -0,0 +1,125 @@
+#ifndef OUTPUT_WRITER_H
+#define OUTPUT_WRITER_H
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+
+#include "trace.h"
+
+namespace Adapter
+{
+  /**
+   * @brief The OutputWriter class runs the generation of result files on
+   *        background threads, so that the time loop (and therefore the
+   *        coupling partner) does not wait for building the patches and
+   *        writing to disk.
+   *
+   *        The caller is responsible for passing a task, which owns a
+   *        snapshot of all data changing during the time loop, e.g., a copy
+   *        of the solution vector. The number of pending tasks is bounded: if
+   *        the queue is full, write() waits for the oldest task to finish
+   *        (back-pressure), such that the memory of the snapshots is bounded
+   *        and a slow file system throttles the simulation instead of
+   *        accumulating work. A queue depth of zero runs the tasks
+   *        synchronously.
+   */
+  class OutputWriter
+  {
+  public:
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  max_queue_depth Maximum number of pending output tasks
+     */
+    OutputWriter(const unsigned int max_queue_depth);
+
+    /**
+     * @brief Destructor, waits for all pending tasks
+     */
+    ~OutputWriter();
+
+    /**
+     * @brief write Runs @p task in the background. Exceptions thrown by the
+     *        task are rethrown by a subsequent call to write() or finalize().
+     */
+    void
+    write(std::function<void()> task);
+
+    /**
+     * @brief finalize Waits for all pending tasks. Needs to be called before
+     *        the end of the simulation in order to catch errors of the
+     *        tasks.
+     */
+    void
+    finalize();
+
+  private:
+    const unsigned int max_queue_depth;
+
+    std::deque<std::future<void>> pending_tasks;
+  };
+
+
+
+  inline OutputWriter::OutputWriter(const unsigned int max_queue_depth)
+    : max_queue_depth(max_queue_depth)
+  {}
+
+
+
+  inline OutputWriter::~OutputWriter()
+  {
+    // Exceptions must not leave the destructor
+    for (auto &task : pending_tasks)
+      if (task.valid())
+        task.wait();
+  }
+
+
+
+  inline void
+  OutputWriter::write(std::function<void()> task)
+  {
+    if (max_queue_depth == 0)
+      {
+        const TraceScope trace("Output task");
+        task();
+        return;
+      }
+
+    // Finished tasks are removed, the oldest task is waited for, if the queue
+    // is full
+    while (!pending_tasks.empty() &&
+           (pending_tasks.size() >= max_queue_depth ||
+            pending_tasks.front().wait_for(std::chrono::seconds(0)) ==
+              std::future_status::ready))
+      {
+        std::future<void> finished_task = std::move(pending_tasks.front());
+        pending_tasks.pop_front();
+        finished_task.get();
+      }
+
+    pending_tasks.push_back(
+      std::async(std::launch::async, [task = std::move(task)]() {
+        const TraceScope trace("Output task");
+        task();
+      }));
+  }
+
+
+
+  inline void
+  OutputWriter::finalize()
+  {
+    while (!pending_tasks.empty())
+      {
+        std::future<void> task = std::move(pending_tasks.front());
+        pending_tasks.pop_front();
+        task.get();
+      }
+  }
+} // namespace Adapter
+
+#endif // OUTPUT_WRITER_H
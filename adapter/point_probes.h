@@ -0,0 +1,208 @@
+#ifndef POINT_PROBES_H
+#define POINT_PROBES_H
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/grid_tools.h>
+
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief The PointProbes class writes the displacement, the velocity and
+   *        the (linearized) strain at a few monitoring points, e.g., the tip
+   *        of a flap, to a CSV file. The cells around the points and the
+   *        shape function values and gradients at the points are computed
+   *        once in the constructor, so that each evaluation only needs the
+   *        DoF values of a single cell per point. The points refer to the
+   *        reference configuration.
+   */
+  template <int dim>
+  class PointProbes
+  {
+  public:
+    /**
+     * @brief      Constructor, locates the points and writes the header of
+     *             the CSV file
+     *
+     * @param[in]  dof_handler DoFHandler of a vector valued element with dim
+     *             components
+     * @param[in]  mapping Mapping of the reference configuration
+     * @param[in]  points Monitoring points
+     * @param[in]  filename Name of the CSV file
+     * @param[in]  append Append to an existing file without a header, e.g.,
+     *             when resuming a simulation
+     */
+    PointProbes(const DoFHandler<dim> &        dof_handler,
+                const Mapping<dim> &           mapping,
+                const std::vector<Point<dim>> &points,
+                const std::string &            filename,
+                const bool                     append = false);
+
+    /**
+     * @brief write Appends one line with the values at all points at time
+     *        @p time
+     */
+    template <typename VectorType>
+    void
+    write(const double      time,
+          const VectorType &displacement,
+          const VectorType &velocity);
+
+    /**
+     * @brief get_dof_indices Returns the DoFs of all cells around the points,
+     *        i.e., all DoF values, on which write() depends
+     */
+    std::vector<types::global_dof_index>
+    get_dof_indices() const;
+
+  private:
+    struct Probe
+    {
+      std::vector<types::global_dof_index> dof_indices;
+      std::vector<double>                  shape_values;
+      std::vector<Tensor<1, dim>>          shape_gradients;
+    };
+
+    std::vector<Probe>        probes;
+    std::vector<unsigned int> shape_components;
+
+    std::ofstream output;
+  };
+
+
+
+  template <int dim>
+  PointProbes<dim>::PointProbes(const DoFHandler<dim> &        dof_handler,
+                                const Mapping<dim> &           mapping,
+                                const std::vector<Point<dim>> &points,
+                                const std::string &            filename,
+                                const bool                     append)
+    : output(filename, append ? std::ios::app : std::ios::out)
+  {
+    const FiniteElement<dim> &fe = dof_handler.get_fe();
+    AssertDimension(fe.n_components(), dim);
+    AssertThrow(output, ExcIO());
+
+    const unsigned int dofs_per_cell = fe.dofs_per_cell;
+    shape_components.resize(dofs_per_cell);
+    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+      shape_components[i] = fe.system_to_component_index(i).first;
+
+    for (const auto &point : points)
+      {
+        const auto cell_and_point =
+          GridTools::find_active_cell_around_point(mapping,
+                                                   dof_handler,
+                                                   point);
+
+        // The inverse mapping may be slightly outside the unit cell for
+        // points on a cell boundary
+        const Quadrature<dim> quadrature(
+          GeometryInfo<dim>::project_to_unit_cell(cell_and_point.second));
+        FEValues<dim> fe_values(mapping,
+                                fe,
+                                quadrature,
+                                update_values | update_gradients);
+        fe_values.reinit(cell_and_point.first);
+
+        Probe probe;
+        probe.dof_indices.resize(dofs_per_cell);
+        cell_and_point.first->get_dof_indices(probe.dof_indices);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          {
+            probe.shape_values.push_back(fe_values.shape_value(i, 0));
+            probe.shape_gradients.push_back(fe_values.shape_grad(i, 0));
+          }
+        probes.push_back(probe);
+      }
+
+    // Header: the columns of each point are prefixed by the point index
+    if (!append)
+      {
+        const std::string coordinates = "xyz";
+        output << "time";
+        for (unsigned int p = 0; p < probes.size(); ++p)
+          {
+            const std::string prefix = "p" + std::to_string(p) + "_";
+            for (unsigned int d = 0; d < dim; ++d)
+              output << "," << prefix << "u_" << coordinates[d];
+            for (unsigned int d = 0; d < dim; ++d)
+              output << "," << prefix << "v_" << coordinates[d];
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int e = d; e < dim; ++e)
+                output << "," << prefix << "eps_" << coordinates[d]
+                       << coordinates[e];
+          }
+        output << std::endl;
+      }
+    output << std::setprecision(10);
+  }
+
+
+
+  template <int dim>
+  std::vector<types::global_dof_index>
+  PointProbes<dim>::get_dof_indices() const
+  {
+    std::vector<types::global_dof_index> dof_indices;
+    for (const auto &probe : probes)
+      dof_indices.insert(dof_indices.end(),
+                         probe.dof_indices.begin(),
+                         probe.dof_indices.end());
+    return dof_indices;
+  }
+
+
+
+  template <int dim>
+  template <typename VectorType>
+  void
+  PointProbes<dim>::write(const double      time,
+                          const VectorType &displacement,
+                          const VectorType &velocity)
+  {
+    output << time;
+    for (const auto &probe : probes)
+      {
+        Tensor<1, dim> u, v;
+        Tensor<2, dim> grad_u;
+        for (unsigned int i = 0; i < probe.dof_indices.size(); ++i)
+          {
+            const unsigned int component = shape_components[i];
+            const auto         dof       = probe.dof_indices[i];
+
+            u[component] += displacement(dof) * probe.shape_values[i];
+            v[component] += velocity(dof) * probe.shape_values[i];
+            grad_u[component] += displacement(dof) * probe.shape_gradients[i];
+          }
+
+        for (unsigned int d = 0; d < dim; ++d)
+          output << "," << u[d];
+        for (unsigned int d = 0; d < dim; ++d)
+          output << "," << v[d];
+        for (unsigned int d = 0; d < dim; ++d)
+          for (unsigned int e = d; e < dim; ++e)
+            output << "," << 0.5 * (grad_u[d][e] + grad_u[e][d]);
+      }
+    // The line is flushed, so that the file can be monitored during the run
+    output << std::endl;
+  }
+} // namespace Adapter
+
+#endif // POINT_PROBES_H
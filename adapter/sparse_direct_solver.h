@@ -0,0 +1,332 @@
+#ifndef SPARSE_DIRECT_SOLVER_H
+#define SPARSE_DIRECT_SOLVER_H
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#ifdef DEAL_II_WITH_UMFPACK
+#  include <umfpack.h>
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief The SparseDirectSolver class wraps a sparse direct solver, which
+   *        is used repeatedly for matrices with a fixed sparsity pattern, as
+   *        it is the case for the Newton iterations and time steps of our
+   *        solvers.
+   *
+   *        The deal.II class SparseDirectUMFPACK recomputes the symbolic
+   *        factorization (fill-reducing ordering and analysis of the fill-in)
+   *        every time it is initialized. Here, the UMFPACK interface is called
+   *        directly instead: the symbolic factorization is computed only once
+   *        per sparsity pattern and each call of @p factorize() performs only
+   *        the numeric factorization of the current matrix values.
+   *
+   *        Alternatively, the MUMPS backend of deal.II (SparseDirectMUMPS)
+   *        can be selected, if deal.II has been configured with MUMPS. MUMPS
+   *        runs in parallel using MPI, but is not multithreaded here and
+   *        computes the symbolic and numeric factorization from scratch in
+   *        each call of @p factorize(), i.e., there is no reuse of the
+   *        symbolic factorization for this backend.
+   */
+  class SparseDirectSolver : public Subscriptor
+  {
+  public:
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  backend Direct solver package, either "UMFPACK" or "MUMPS"
+     */
+    SparseDirectSolver(const std::string &backend = "UMFPACK");
+
+    ~SparseDirectSolver();
+
+    SparseDirectSolver(const SparseDirectSolver &) = delete;
+
+    SparseDirectSolver &
+    operator=(const SparseDirectSolver &) = delete;
+
+    /**
+     * @brief factorize Computes the factorization of @p matrix. The symbolic
+     *        factorization is only recomputed, if the sparsity pattern of the
+     *        matrix differs from the one of the previous call.
+     */
+    void
+    factorize(const SparseMatrix<double> &matrix);
+
+    /**
+     * @brief vmult Solves the system with the factorized matrix, i.e.,
+     *        computes dst = A^{-1} src.
+     */
+    void
+    vmult(Vector<double> &dst, const Vector<double> &src) const;
+
+    /**
+     * @brief clear Frees all factorizations, so that the next call of
+     *        @p factorize() starts with a symbolic factorization again.
+     */
+    void
+    clear();
+
+  private:
+    const std::string backend;
+
+#ifdef DEAL_II_WITH_UMFPACK
+    // Sets up the compressed row arrays Ap and Ai in sorted order and the
+    // permutation from the storage order of the deal.II matrix to the sorted
+    // order
+    void
+    setup_pattern(const SparseMatrix<double> &matrix);
+
+    // Copies the values of the deal.II matrix into Ax
+    void
+    copy_values(const SparseMatrix<double> &matrix);
+
+    // Sparsity pattern of the current symbolic factorization
+    const SparsityPattern *sparsity_pattern;
+    std::size_t            n_nonzero_elements;
+
+    std::vector<SuiteSparse_long> Ap;
+    std::vector<SuiteSparse_long> Ai;
+    std::vector<double>           Ax;
+    std::vector<std::size_t>      storage_to_sorted;
+
+    void *symbolic_decomposition;
+    void *numeric_decomposition;
+
+    std::vector<double> control;
+#endif
+
+#ifdef DEAL_II_WITH_MUMPS
+    std::unique_ptr<SparseDirectMUMPS> mumps;
+#endif
+  };
+
+
+
+  inline
+  SparseDirectSolver::SparseDirectSolver(const std::string &backend)
+    : backend(backend)
+#ifdef DEAL_II_WITH_UMFPACK
+    , sparsity_pattern(nullptr)
+    , n_nonzero_elements(0)
+    , symbolic_decomposition(nullptr)
+    , numeric_decomposition(nullptr)
+    , control(UMFPACK_CONTROL)
+#endif
+  {
+    AssertThrow(backend == "UMFPACK" || backend == "MUMPS",
+                ExcMessage("Unknown direct solver " + backend));
+#ifdef DEAL_II_WITH_UMFPACK
+    umfpack_dl_defaults(control.data());
+#endif
+  }
+
+
+
+  inline
+  SparseDirectSolver::~SparseDirectSolver()
+  {
+    clear();
+  }
+
+
+
+  inline void
+  SparseDirectSolver::clear()
+  {
+#ifdef DEAL_II_WITH_UMFPACK
+    if (symbolic_decomposition != nullptr)
+      umfpack_dl_free_symbolic(&symbolic_decomposition);
+    if (numeric_decomposition != nullptr)
+      umfpack_dl_free_numeric(&numeric_decomposition);
+
+    symbolic_decomposition = nullptr;
+    numeric_decomposition  = nullptr;
+    sparsity_pattern       = nullptr;
+    n_nonzero_elements     = 0;
+#endif
+#ifdef DEAL_II_WITH_MUMPS
+    mumps.reset();
+#endif
+  }
+
+
+
+  inline void
+  SparseDirectSolver::factorize(const SparseMatrix<double> &matrix)
+  {
+    Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+#ifndef DEAL_II_WITH_UMFPACK
+    AssertThrow(backend != "UMFPACK",
+                ExcMessage("deal.II has not been configured with UMFPACK"));
+#endif
+#ifndef DEAL_II_WITH_MUMPS
+    AssertThrow(backend != "MUMPS",
+                ExcMessage("deal.II has not been configured with MUMPS"));
+#endif
+
+#ifdef DEAL_II_WITH_MUMPS
+    if (backend == "MUMPS")
+      {
+        mumps.reset(new SparseDirectMUMPS());
+        mumps->initialize(matrix);
+        return;
+      }
+#endif
+
+#ifdef DEAL_II_WITH_UMFPACK
+    // Redo the symbolic factorization only for a new sparsity pattern
+    if (sparsity_pattern != &matrix.get_sparsity_pattern() ||
+        n_nonzero_elements != matrix.n_nonzero_elements())
+      {
+        clear();
+        setup_pattern(matrix);
+        copy_values(matrix);
+
+        const SuiteSparse_long n      = matrix.m();
+        const int              status = umfpack_dl_symbolic(n,
+                                                   n,
+                                                   Ap.data(),
+                                                   Ai.data(),
+                                                   Ax.data(),
+                                                   &symbolic_decomposition,
+                                                   control.data(),
+                                                   nullptr);
+        AssertThrow(status == UMFPACK_OK,
+                    ExcMessage("UMFPACK symbolic factorization failed with " +
+                               std::to_string(status)));
+
+        sparsity_pattern   = &matrix.get_sparsity_pattern();
+        n_nonzero_elements = matrix.n_nonzero_elements();
+      }
+    else
+      copy_values(matrix);
+
+    if (numeric_decomposition != nullptr)
+      umfpack_dl_free_numeric(&numeric_decomposition);
+
+    const int status = umfpack_dl_numeric(Ap.data(),
+                                          Ai.data(),
+                                          Ax.data(),
+                                          symbolic_decomposition,
+                                          &numeric_decomposition,
+                                          control.data(),
+                                          nullptr);
+    AssertThrow(status == UMFPACK_OK,
+                ExcMessage("UMFPACK numeric factorization failed with " +
+                           std::to_string(status)));
+#endif
+  }
+
+
+
+  inline void
+  SparseDirectSolver::vmult(Vector<double> &      dst,
+                            const Vector<double> &src) const
+  {
+#ifdef DEAL_II_WITH_MUMPS
+    if (backend == "MUMPS")
+      {
+        Assert(mumps != nullptr, ExcNotInitialized());
+        mumps->vmult(dst, src);
+        return;
+      }
+#endif
+
+#ifdef DEAL_II_WITH_UMFPACK
+    Assert(numeric_decomposition != nullptr, ExcNotInitialized());
+    AssertDimension(dst.size(), Ap.size() - 1);
+    AssertDimension(src.size(), Ap.size() - 1);
+
+    // Ap, Ai and Ax describe the matrix in compressed row format, which is the
+    // compressed column format of its transpose. Hence, we solve with A^T in
+    // terms of UMFPACK
+    const int status = umfpack_dl_solve(UMFPACK_At,
+                                        Ap.data(),
+                                        Ai.data(),
+                                        Ax.data(),
+                                        dst.begin(),
+                                        src.begin(),
+                                        numeric_decomposition,
+                                        control.data(),
+                                        nullptr);
+    AssertThrow(status == UMFPACK_OK,
+                ExcMessage("UMFPACK solve failed with " +
+                           std::to_string(status)));
+#else
+    (void)dst;
+    (void)src;
+#endif
+  }
+
+
+
+#ifdef DEAL_II_WITH_UMFPACK
+  inline void
+  SparseDirectSolver::setup_pattern(const SparseMatrix<double> &matrix)
+  {
+    const SparsityPattern &pattern = matrix.get_sparsity_pattern();
+    const std::size_t      n_rows  = matrix.m();
+
+    Ap.resize(n_rows + 1);
+    Ai.resize(matrix.n_nonzero_elements());
+    Ax.resize(matrix.n_nonzero_elements());
+    storage_to_sorted.resize(matrix.n_nonzero_elements());
+
+    // deal.II stores the diagonal element first in each row, whereas UMFPACK
+    // expects sorted column indices
+    std::vector<std::pair<SuiteSparse_long, std::size_t>> row_entries;
+    std::size_t                                           index = 0;
+
+    Ap[0] = 0;
+    for (std::size_t row = 0; row < n_rows; ++row)
+      {
+        row_entries.clear();
+        for (auto entry = pattern.begin(row); entry != pattern.end(row);
+             ++entry, ++index)
+          row_entries.emplace_back(entry->column(), index);
+
+        std::sort(row_entries.begin(), row_entries.end());
+
+        for (std::size_t k = 0; k < row_entries.size(); ++k)
+          {
+            Ai[Ap[row] + k]                          = row_entries[k].first;
+            storage_to_sorted[row_entries[k].second] = Ap[row] + k;
+          }
+        Ap[row + 1] = Ap[row] + row_entries.size();
+      }
+
+    AssertDimension(index, matrix.n_nonzero_elements());
+  }
+
+
+
+  inline void
+  SparseDirectSolver::copy_values(const SparseMatrix<double> &matrix)
+  {
+    // The matrix iterators traverse the entries in storage order
+    std::size_t index = 0;
+    for (auto entry = matrix.begin(); entry != matrix.end(); ++entry, ++index)
+      Ax[storage_to_sorted[index]] = entry->value();
+
+    AssertDimension(index, Ax.size());
+  }
+#endif
+} // namespace Adapter
+
+#endif // SPARSE_DIRECT_SOLVER_H
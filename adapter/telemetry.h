@@ -0,0 +1,261 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/timer.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief The Telemetry class writes one record per coupling iteration,
+   *        i.e., per call of the time loop body, in contrast to the summary
+   *        of the TimerOutput at the end of the simulation. Each record
+   *        contains
+   *
+   *        - the time step, the time and the (implicit) coupling iteration
+   *          within the time window. The record of the last iteration of a
+   *          window is marked by window_complete, so its iteration is the
+   *          number of implicit iterations of the window
+   *        - the wall time spent in the given sections of the TimerOutput
+   *          since the previous record
+   *        - the given counters, e.g., Newton or CG iterations, accumulated
+   *          since the previous record
+   *
+   *        The records are written as JSON lines or as CSV. The phases are
+   *        measured by the TimerOutput of the solver, so that the telemetry
+   *        does not add any timers. The keys are the section names in lower
+   *        case with underscores, e.g. 'Assemble rhs' becomes 'assemble_rhs'.
+   */
+  class Telemetry
+  {
+  public:
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  format One of off, jsonl or csv
+     * @param[in]  filename Name of the output file, which is not created for
+     *             the format off
+     * @param[in]  sections Sections of the TimerOutput to be recorded
+     * @param[in]  counters Names of the counters
+     */
+    Telemetry(const std::string &             format,
+              const std::string &             filename,
+              const std::vector<std::string> &sections,
+              const std::vector<std::string> &counters);
+
+    /**
+     * @brief enabled Returns false for the format off
+     */
+    bool
+    enabled() const
+    {
+      return format != "off";
+    }
+
+    /**
+     * @brief start Takes the times of @p timer as reference for the first
+     *        record and resets the counters, e.g., before the time loop
+     */
+    void
+    start(const TimerOutput &timer);
+
+    /**
+     * @brief begin_iteration Sets the time step and the time of the next
+     *        record
+     */
+    void
+    begin_iteration(const unsigned int timestep, const double time);
+
+    /**
+     * @brief count Adds @p n to the counter @p counter
+     */
+    void
+    count(const std::string &counter, const unsigned int n);
+
+    /**
+     * @brief end_iteration Writes the record of the current coupling
+     *        iteration
+     *
+     * @param[in]  timer TimerOutput, which measures the sections
+     * @param[in]  window_complete Whether the time window is complete after
+     *             this iteration
+     */
+    void
+    end_iteration(const TimerOutput &timer, const bool window_complete);
+
+  private:
+    const std::string format;
+    std::ofstream     output;
+
+    const std::vector<std::string> sections;
+    const std::vector<std::string> counters;
+
+    // Accumulated section times of the previous record
+    std::vector<double> previous_times;
+    // Counters since the previous record
+    std::vector<unsigned long int> counts;
+
+    unsigned int timestep;
+    double       time;
+    unsigned int iteration;
+
+    static std::string
+    to_key(const std::string &name);
+  };
+
+
+
+  inline Telemetry::Telemetry(const std::string &             format,
+                              const std::string &             filename,
+                              const std::vector<std::string> &sections,
+                              const std::vector<std::string> &counters)
+    : format(format)
+    , sections(sections)
+    , counters(counters)
+    , previous_times(sections.size(), 0.)
+    , counts(counters.size(), 0)
+    , timestep(0)
+    , time(0.)
+    , iteration(0)
+  {
+    AssertThrow(format == "off" || format == "jsonl" || format == "csv",
+                ExcMessage("Unknown telemetry format " + format));
+    if (!enabled())
+      return;
+
+    output.open(filename);
+    AssertThrow(output, ExcFileNotOpen(filename));
+    output << std::setprecision(6);
+
+    if (format == "csv")
+      {
+        output << "timestep,time,iteration,window_complete";
+        for (const auto &section : sections)
+          output << "," << to_key(section);
+        for (const auto &counter : counters)
+          output << "," << counter;
+        output << "\n";
+      }
+  }
+
+
+
+  inline void
+  Telemetry::start(const TimerOutput &timer)
+  {
+    if (!enabled())
+      return;
+
+    const std::map<std::string, double> times =
+      timer.get_summary_data(TimerOutput::total_wall_time);
+    for (unsigned int i = 0; i < sections.size(); ++i)
+      {
+        const auto entry  = times.find(sections[i]);
+        previous_times[i] = entry != times.end() ? entry->second : 0.;
+      }
+    std::fill(counts.begin(), counts.end(), 0);
+    iteration = 0;
+  }
+
+
+
+  inline void
+  Telemetry::begin_iteration(const unsigned int timestep, const double time)
+  {
+    this->timestep = timestep;
+    this->time     = time;
+  }
+
+
+
+  inline void
+  Telemetry::count(const std::string &counter, const unsigned int n)
+  {
+    if (!enabled())
+      return;
+
+    const auto position = std::find(counters.begin(), counters.end(), counter);
+    Assert(position != counters.end(),
+           ExcMessage("Unknown telemetry counter " + counter));
+    counts[position - counters.begin()] += n;
+  }
+
+
+
+  inline void
+  Telemetry::end_iteration(const TimerOutput &timer, const bool window_complete)
+  {
+    if (!enabled())
+      return;
+
+    ++iteration;
+
+    // The sections are only updated, when they are left, so that all
+    // sections need to be closed here
+    const std::map<std::string, double> times =
+      timer.get_summary_data(TimerOutput::total_wall_time);
+    std::vector<double> phase_times(sections.size());
+    for (unsigned int i = 0; i < sections.size(); ++i)
+      {
+        const auto   entry = times.find(sections[i]);
+        const double total = entry != times.end() ? entry->second : 0.;
+        phase_times[i]     = total - previous_times[i];
+        previous_times[i]  = total;
+      }
+
+    if (format == "jsonl")
+      {
+        output << "{\"timestep\": " << timestep << ", \"time\": " << time
+               << ", \"iteration\": " << iteration << ", \"window_complete\": "
+               << (window_complete ? "true" : "false");
+        for (unsigned int i = 0; i < sections.size(); ++i)
+          output << ", \"" << to_key(sections[i]) << "\": " << phase_times[i];
+        for (unsigned int i = 0; i < counters.size(); ++i)
+          output << ", \"" << counters[i] << "\": " << counts[i];
+        output << "}\n";
+      }
+    else
+      {
+        output << timestep << "," << time << "," << iteration << ","
+               << window_complete;
+        for (const double phase_time : phase_times)
+          output << "," << phase_time;
+        for (const auto count : counts)
+          output << "," << count;
+        output << "\n";
+      }
+    // Flushed at the end of each window, so that the file can be monitored
+    // during the run
+    if (window_complete)
+      output.flush();
+
+    std::fill(counts.begin(), counts.end(), 0);
+    if (window_complete)
+      iteration = 0;
+  }
+
+
+
+  inline std::string
+  Telemetry::to_key(const std::string &name)
+  {
+    std::string key;
+    for (const char c : name)
+      key += (c == ' ') ?
+               '_' :
+               static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return key;
+  }
+} // namespace Adapter
+
+#endif // TELEMETRY_H
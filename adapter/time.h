@@ -74,6 +74,18 @@ namespace Adapter
       ++timestep;
     }
 
+    /**
+     * @brief serialize Writes or reads the current time and time step, e.g.,
+     *        for restart files. The end time and the time step size are
+     *        given by the parameters.
+     */
+    template <class Archive>
+    void
+    serialize(Archive &ar, const unsigned int /*version*/)
+    {
+      ar &timestep &time_current;
+    }
+
   private:
     unsigned int timestep;
     double       time_current;
@@ -0,0 +1,220 @@
+#ifndef TIME_SERIES_WRITER_H
+#define TIME_SERIES_WRITER_H
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief The TimeSeriesWriter class writes the patches of a DataOut object
+   *        in one of the following formats:
+   *
+   *        - vtk: one legacy ASCII file per output step
+   *        - vtu: one binary, compressed file per output step and a .pvd
+   *          file, which lists all steps with their time
+   *        - hdf5: the mesh is written once to an HDF5 file, each output
+   *          step only appends an HDF5 file with the solution fields. An
+   *          XDMF file lists all steps with their time. Since the mesh is
+   *          written once, the patches need to be built on the reference
+   *          configuration, i.e., the deformation has to be applied in the
+   *          viewer (e.g. 'Warp By Vector' in ParaView).
+   *
+   *        The write() function may be called concurrently from several
+   *        output tasks, except for the hdf5 format: the HDF5 output of
+   *        deal.II uses MPI, which must not be called concurrently with the
+   *        coupling library.
+   *
+   *        The patches may be of lower dimension than the space, e.g., the
+   *        faces of DataOutFaces.
+   */
+  template <int dim, int spacedim = dim>
+  class TimeSeriesWriter
+  {
+  public:
+    /**
+     * @brief      Constructor
+     *
+     * @param[in]  format One of vtk, vtu or hdf5
+     * @param[in]  output_directory Directory of the result files including
+     *             a trailing slash, or an empty string
+     * @param[in]  basename Common prefix of the result files
+     */
+    TimeSeriesWriter(const std::string &format,
+                     const std::string &output_directory,
+                     const std::string &basename = "solution");
+
+    /**
+     * @brief write Writes the patches of @p data_out as output step
+     *        @p index at time @p time
+     */
+    void
+    write(DataOutInterface<dim, spacedim> &data_out,
+          const unsigned int               index,
+          const double                     time);
+
+    /**
+     * @brief reference_geometry Returns true, if the format requires the
+     *        patches to be built on the reference configuration
+     */
+    bool
+    reference_geometry() const
+    {
+      return format == "hdf5";
+    }
+
+    /**
+     * @brief supports_concurrent_writes Returns false, if write() needs to be
+     *        called from the main thread
+     */
+    bool
+    supports_concurrent_writes() const
+    {
+      return format != "hdf5";
+    }
+
+    /**
+     * @brief get_filename Returns the name of the result file of output step
+     *        @p index without the output directory
+     */
+    std::string
+    get_filename(const unsigned int index) const;
+
+  private:
+    const std::string format;
+    const std::string output_directory;
+    const std::string basename;
+
+    // Guards the time series records, which are shared by all output tasks
+    std::mutex mutex;
+
+    // Time and file name of all written steps for the .pvd file
+    std::vector<std::pair<double, std::string>> pvd_records;
+
+    // Time and entry of all written steps for the XDMF file
+    std::vector<std::pair<double, XDMFEntry>> xdmf_entries;
+    bool                                      mesh_written;
+  };
+
+
+
+  template <int dim, int spacedim>
+  TimeSeriesWriter<dim, spacedim>::TimeSeriesWriter(
+    const std::string &format,
+    const std::string &output_directory,
+    const std::string &basename)
+    : format(format)
+    , output_directory(output_directory)
+    , basename(basename)
+    , mesh_written(false)
+  {
+    AssertThrow(format == "vtk" || format == "vtu" || format == "hdf5",
+                ExcMessage("Unknown output format " + format));
+#ifndef DEAL_II_WITH_HDF5
+    AssertThrow(format != "hdf5",
+                ExcMessage("The hdf5 output format requires deal.II to be "
+                           "configured with HDF5"));
+#endif
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::string
+  TimeSeriesWriter<dim, spacedim>::get_filename(const unsigned int index) const
+  {
+    return basename + "-" + std::to_string(index) + "." +
+           (format == "hdf5" ? "h5" : format);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  TimeSeriesWriter<dim, spacedim>::write(
+    DataOutInterface<dim, spacedim> &data_out,
+    const unsigned int               index,
+    const double                     time)
+  {
+    const std::string filename = get_filename(index);
+
+    if (format == "vtk" || format == "vtu")
+      {
+        // Note: There is at least paraView v 5.5 needed to visualize this
+        // output
+        DataOutBase::VtkFlags flags;
+        flags.write_higher_order_cells = true;
+        flags.compression_level        = DataOutBase::VtkFlags::best_speed;
+        data_out.set_flags(flags);
+
+        std::ofstream output(output_directory + filename);
+        if (format == "vtk")
+          {
+            data_out.write_vtk(output);
+            return;
+          }
+        data_out.write_vtu(output);
+
+        // Tasks may finish in any order, so that the records are sorted
+        std::lock_guard<std::mutex> lock(mutex);
+        pvd_records.emplace_back(time, filename);
+        std::sort(pvd_records.begin(), pvd_records.end());
+
+        std::ofstream pvd_output(output_directory + basename + ".pvd");
+        DataOutBase::write_pvd_record(pvd_output, pvd_records);
+      }
+    else
+      {
+#ifdef DEAL_II_WITH_HDF5
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Duplicate vertices of neighboring patches are merged, which keeps
+        // the mesh file small
+        DataOutBase::DataOutFilter data_filter(
+          DataOutBase::DataOutFilterFlags(true, true));
+        data_out.write_filtered_data(data_filter);
+
+        const std::string mesh_filename = basename + "-mesh.h5";
+        data_out.write_hdf5_parallel(data_filter,
+                                     !mesh_written,
+                                     output_directory + mesh_filename,
+                                     output_directory + filename,
+                                     MPI_COMM_SELF);
+        mesh_written = true;
+
+        xdmf_entries.emplace_back(time,
+                                  data_out.create_xdmf_entry(data_filter,
+                                                             mesh_filename,
+                                                             filename,
+                                                             time,
+                                                             MPI_COMM_SELF));
+        std::sort(xdmf_entries.begin(),
+                  xdmf_entries.end(),
+                  [](const auto &a, const auto &b) {
+                    return a.first < b.first;
+                  });
+
+        std::vector<XDMFEntry> entries;
+        for (const auto &entry : xdmf_entries)
+          entries.push_back(entry.second);
+        data_out.write_xdmf_file(entries,
+                                 output_directory + basename + ".xdmf",
+                                 MPI_COMM_SELF);
+#else
+        Assert(false, ExcNeedsHDF5());
+#endif
+      }
+  }
+} // namespace Adapter
+
+#endif // TIME_SERIES_WRITER_H
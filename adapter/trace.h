@@ -0,0 +1,253 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <deal.II/base/exceptions.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Adapter
+{
+  using namespace dealii;
+
+  /**
+   * @brief The Trace class records the begin and the end of phases on all
+   *        threads, e.g., the cells of a WorkStream assembly on the worker
+   *        threads, the copier, the linear solver or the wait in preCICE, and
+   *        writes them in the Chrome trace event format. The file can be
+   *        viewed in Perfetto (ui.perfetto.dev) or chrome://tracing, which
+   *        shows one timeline per thread, so that load imbalance and the
+   *        serialization of the copier become visible.
+   *
+   *        Each thread records into its own ring buffer, so that recording
+   *        does not need any synchronization. If a buffer is full, the oldest
+   *        events are overwritten. If tracing is not enabled, a TraceScope
+   *        only checks a flag.
+   *
+   *        All functions are static, since the phases are spread over the
+   *        solver, the Adapter and the assemblers.
+   */
+  class Trace
+  {
+  public:
+    /**
+     * @brief enable Starts the recording
+     *
+     * @param[in]  buffer_size Number of events, which are kept per thread
+     */
+    static void
+    enable(const unsigned int buffer_size = 1 << 16);
+
+    /**
+     * @brief enabled Returns whether the recording is enabled
+     */
+    static bool
+    enabled()
+    {
+      return get_state().enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief record Adds a phase @p name from @p begin to @p end to the
+     *        buffer of the calling thread. @p name has to be a string
+     *        literal, since only the pointer is stored.
+     */
+    static void
+    record(const char *                                name,
+           const std::chrono::steady_clock::time_point begin,
+           const std::chrono::steady_clock::time_point end);
+
+    /**
+     * @brief write Writes the recorded events of all threads to @p filename
+     *        in the Chrome trace event format. Must not be called
+     *        concurrently with the recording, e.g., at the end of the
+     *        simulation.
+     */
+    static void
+    write(const std::string &filename);
+
+  private:
+    struct Event
+    {
+      const char * name;
+      std::int64_t begin;    // nanoseconds since enable()
+      std::int64_t duration; // nanoseconds
+    };
+
+    struct Buffer
+    {
+      unsigned int       thread_id;
+      std::vector<Event> events;
+      // Number of recorded events including the overwritten ones
+      std::size_t n_recorded = 0;
+    };
+
+    struct State
+    {
+      std::atomic<bool>                     enabled{false};
+      unsigned int                          buffer_size = 0;
+      std::chrono::steady_clock::time_point origin;
+      // Guards the list of buffers, which is only modified, when a thread
+      // records its first event
+      std::mutex                           mutex;
+      std::vector<std::shared_ptr<Buffer>> buffers;
+    };
+
+    static State &
+    get_state()
+    {
+      static State state;
+      return state;
+    }
+
+    static Buffer &
+    get_buffer();
+  };
+
+
+
+  /**
+   * @brief The TraceScope class records the phase @p name from its
+   *        construction to its destruction, if tracing is enabled, e.g.,
+   *
+   * @code
+   *   {
+   *     const Adapter::TraceScope trace("Solve linear system");
+   *     ...
+   *   }
+   * @endcode
+   */
+  class TraceScope
+  {
+  public:
+    TraceScope(const char *name)
+      : name(Trace::enabled() ? name : nullptr)
+    {
+      if (this->name != nullptr)
+        begin = std::chrono::steady_clock::now();
+    }
+
+    ~TraceScope()
+    {
+      if (name != nullptr)
+        Trace::record(name, begin, std::chrono::steady_clock::now());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+
+    TraceScope &
+    operator=(const TraceScope &) = delete;
+
+  private:
+    const char *                          name;
+    std::chrono::steady_clock::time_point begin;
+  };
+
+
+
+  inline void
+  Trace::enable(const unsigned int buffer_size)
+  {
+    AssertThrow(buffer_size > 0, ExcMessage("The trace buffer is empty"));
+
+    State &state      = get_state();
+    state.buffer_size = buffer_size;
+    state.origin      = std::chrono::steady_clock::now();
+    state.enabled.store(true);
+  }
+
+
+
+  inline Trace::Buffer &
+  Trace::get_buffer()
+  {
+    // The buffer is owned by the list of buffers, so that the events remain
+    // available after the thread has terminated
+    thread_local Buffer *buffer = nullptr;
+    if (buffer == nullptr)
+      {
+        State &                     state = get_state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        auto new_buffer       = std::make_shared<Buffer>();
+        new_buffer->thread_id = state.buffers.size();
+        new_buffer->events.resize(state.buffer_size);
+        state.buffers.push_back(new_buffer);
+        buffer = new_buffer.get();
+      }
+    return *buffer;
+  }
+
+
+
+  inline void
+  Trace::record(const char *                                name,
+                const std::chrono::steady_clock::time_point begin,
+                const std::chrono::steady_clock::time_point end)
+  {
+    const auto origin = get_state().origin;
+    Buffer &   buffer = get_buffer();
+
+    Event &event = buffer.events[buffer.n_recorded % buffer.events.size()];
+    event.name   = name;
+    event.begin =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(begin - origin)
+        .count();
+    event.duration =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+        .count();
+    ++buffer.n_recorded;
+  }
+
+
+
+  inline void
+  Trace::write(const std::string &filename)
+  {
+    State &                     state = get_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    std::ofstream output(filename);
+    AssertThrow(output, ExcFileNotOpen(filename));
+    output << std::fixed << std::setprecision(3);
+
+    // Complete events ('X') with time stamps in microseconds, one thread
+    // name ('M') per buffer
+    output << "{\"traceEvents\": [\n";
+    bool first = true;
+    for (const auto &buffer : state.buffers)
+      {
+        output << (first ? "" : ",\n")
+               << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, "
+               << "\"tid\": " << buffer->thread_id
+               << ", \"args\": {\"name\": \"thread " << buffer->thread_id
+               << "\"}}";
+        first = false;
+
+        const std::size_t capacity = buffer->events.size();
+        const std::size_t n_events = std::min(buffer->n_recorded, capacity);
+        // Oldest event first, if the buffer has been overwritten
+        const std::size_t offset =
+          buffer->n_recorded > capacity ? buffer->n_recorded % capacity : 0;
+        for (std::size_t i = 0; i < n_events; ++i)
+          {
+            const Event &event = buffer->events[(offset + i) % capacity];
+            output << ",\n{\"name\": \"" << event.name
+                   << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": "
+                   << buffer->thread_id << ", \"ts\": " << 1e-3 * event.begin
+                   << ", \"dur\": " << 1e-3 * event.duration << "}";
+          }
+      }
+    output << "\n], \"displayTimeUnit\": \"ms\"}\n";
+  }
+} // namespace Adapter
+
+#endif // TRACE_H
@@ -3,6 +3,10 @@
 
 #include <deal.II/base/parameter_handler.h>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include "../../adapter/precice_parameter.h"
 
 namespace Linear_Elasticity
@@ -22,6 +26,11 @@ namespace Linear_Elasticity
       double delta_t;
       double end_time;
       int    output_interval;
+      int    output_queue_depth;
+
+      std::string  output_format;
+      std::string  output_geometry;
+      unsigned int output_subdivisions;
 
       static void
       declare_parameters(ParameterHandler &prm);
@@ -46,6 +55,31 @@ namespace Linear_Elasticity
                           "1",
                           Patterns::Integer(0),
                           "Write results every x timesteps");
+
+        prm.declare_entry("Output queue depth",
+                          "2",
+                          Patterns::Integer(0),
+                          "Number of results written in the background, 0 "
+                          "writes synchronously");
+
+        prm.declare_entry("Output format",
+                          "vtk",
+                          Patterns::Selection("vtk|vtu|hdf5"),
+                          "Output format: vtk, vtu (compressed, with a .pvd "
+                          "time series) or hdf5 (with an XDMF time series)");
+
+        prm.declare_entry("Output geometry",
+                          "Deformed",
+                          Patterns::Selection("Deformed|Reference"),
+                          "Output geometry: Deformed (rebuilt in each output "
+                          "step) or Reference (built once, warped in the "
+                          "viewer)");
+
+        prm.declare_entry("Output subdivisions",
+                          "0",
+                          Patterns::Integer(0),
+                          "Subdivisions of each cell in the output, 0 uses "
+                          "the polynomial degree");
       }
       prm.leave_subsection();
     }
@@ -55,21 +89,34 @@ namespace Linear_Elasticity
     {
       prm.enter_subsection("Time");
       {
-        end_time        = prm.get_double("End time");
-        delta_t         = prm.get_double("Time step size");
-        output_interval = prm.get_integer("Output interval");
+        end_time            = prm.get_double("End time");
+        delta_t             = prm.get_double("Time step size");
+        output_interval     = prm.get_integer("Output interval");
+        output_queue_depth  = prm.get_integer("Output queue depth");
+        output_format       = prm.get("Output format");
+        output_geometry     = prm.get("Output geometry");
+        output_subdivisions = prm.get_integer("Output subdivisions");
       }
       prm.leave_subsection();
     }
 
     /**
      * @brief Discretization: Specifies parameters for time integration by a
-     *        theta scheme and polynomial degree of the FE system
+     *        theta or generalized-alpha scheme and polynomial degree of the FE
+     *        system
      */
     struct Discretization
     {
+      std::string  time_integration;
       double       theta;
+      double       spectral_radius;
+      double       alpha_m;
+      double       alpha_f;
+      double       beta;
+      double       gamma;
       unsigned int poly_degree;
+      std::string  dof_renumbering;
+      bool         mapping_cache;
 
       static void
       declare_parameters(ParameterHandler &prm);
@@ -83,6 +130,18 @@ namespace Linear_Elasticity
     {
       prm.enter_subsection("Discretization");
       {
+        prm.declare_entry("Time integration",
+                          "Theta",
+                          Patterns::Selection("Theta|Generalized-alpha"),
+                          "Time integration scheme: Theta or "
+                          "Generalized-alpha");
+
+        prm.declare_entry("Spectral radius",
+                          "0.8",
+                          Patterns::Double(0, 1),
+                          "Spectral radius at infinite frequency of the "
+                          "generalized-alpha scheme");
+
         prm.declare_entry("theta",
                           "0.5",
                           Patterns::Double(0, 1),
@@ -92,6 +151,19 @@ namespace Linear_Elasticity
                           "3",
                           Patterns::Integer(0),
                           "Polynomial degree of the FE system");
+
+        prm.declare_entry("DoF renumbering",
+                          "None",
+                          Patterns::Selection(
+                            "None|Cuthill-McKee|Hilbert|Component-wise"),
+                          "DoF renumbering: None, Cuthill-McKee, Hilbert or "
+                          "Component-wise");
+
+        prm.declare_entry("Mapping cache",
+                          "true",
+                          Patterns::Bool(),
+                          "Precompute the mapping support points of all "
+                          "cells once");
       }
       prm.leave_subsection();
     }
@@ -101,8 +173,20 @@ namespace Linear_Elasticity
     {
       prm.enter_subsection("Discretization");
       {
-        theta       = prm.get_double("theta");
-        poly_degree = prm.get_integer("Polynomial degree");
+        theta           = prm.get_double("theta");
+        poly_degree     = prm.get_integer("Polynomial degree");
+        dof_renumbering = prm.get("DoF renumbering");
+        mapping_cache   = prm.get_bool("Mapping cache");
+
+        time_integration = prm.get("Time integration");
+        spectral_radius  = prm.get_double("Spectral radius");
+
+        // Parameters of the generalized-alpha method (Chung and Hulbert),
+        // which is formulated in terms of Newmark's kinematic relations
+        alpha_m = (2. * spectral_radius - 1.) / (spectral_radius + 1.);
+        alpha_f = spectral_radius / (spectral_radius + 1.);
+        gamma   = 0.5 - alpha_m + alpha_f;
+        beta    = 0.25 * std::pow(1. - alpha_m + alpha_f, 2);
       }
       prm.leave_subsection();
     }
@@ -165,9 +249,14 @@ namespace Linear_Elasticity
      */
     struct LinearSolver
     {
-      std::string type_lin;
-      double      tol_lin;
-      double      max_iterations_lin;
+      std::string  type_lin;
+      std::string  direct_solver;
+      double       tol_lin;
+      double       max_iterations_lin;
+      unsigned int deflation_vectors;
+      std::string  matrix_format;
+      std::string  precision;
+      bool         interface_influence;
 
       static void
       declare_parameters(ParameterHandler &prm);
@@ -183,8 +272,16 @@ namespace Linear_Elasticity
       {
         prm.declare_entry("Solver type",
                           "Direct",
-                          Patterns::Selection("CG|Direct"),
-                          "Linear solver: CG or Direct");
+                          Patterns::Selection("CG|Deflated CG|Direct"),
+                          "Linear solver: CG, Deflated CG or Direct");
+
+        prm.declare_entry("Direct solver",
+                          "UMFPACK",
+                          Patterns::Selection("UMFPACK|MUMPS"),
+                          "Direct solver package: UMFPACK (reuses the "
+                          "symbolic factorization) or MUMPS (MPI parallel, "
+                          "factorizes from scratch, requires deal.II with "
+                          "MUMPS)");
 
         prm.declare_entry("Residual",
                           "1e-6",
@@ -196,6 +293,31 @@ namespace Linear_Elasticity
           "1",
           Patterns::Double(0.0),
           "Linear solver iterations (multiples of the system matrix size)");
+
+        prm.declare_entry("Deflation vectors",
+                          "10",
+                          Patterns::Integer(0),
+                          "Number of recycled vectors of the Deflated CG");
+
+        prm.declare_entry("Matrix format",
+                          "CSR",
+                          Patterns::Selection("CSR|Node-blocked"),
+                          "Matrix format of the iterative solvers: CSR or "
+                          "Node-blocked");
+
+        prm.declare_entry("Precision",
+                          "Double",
+                          Patterns::Selection("Double|Mixed"),
+                          "Precision of the CG solver: Double or Mixed (single "
+                          "precision matrix with iterative refinement). Mixed "
+                          "stores a single precision copy of the matrix in "
+                          "addition, trading memory for bandwidth");
+
+        prm.declare_entry("Interface influence matrix",
+                          "false",
+                          Patterns::Bool(),
+                          "Precompute the response of the interface to unit "
+                          "interface loads");
       }
       prm.leave_subsection();
     }
@@ -205,9 +327,176 @@ namespace Linear_Elasticity
     {
       prm.enter_subsection("Linear solver");
       {
-        type_lin           = prm.get("Solver type");
-        tol_lin            = prm.get_double("Residual");
-        max_iterations_lin = prm.get_double("Max iteration multiplier");
+        type_lin            = prm.get("Solver type");
+        direct_solver       = prm.get("Direct solver");
+        tol_lin             = prm.get_double("Residual");
+        max_iterations_lin  = prm.get_double("Max iteration multiplier");
+        deflation_vectors   = prm.get_integer("Deflation vectors");
+        matrix_format       = prm.get("Matrix format");
+        precision           = prm.get("Precision");
+        interface_influence = prm.get_bool("Interface influence matrix");
+
+#ifndef DEAL_II_WITH_MUMPS
+        AssertThrow(direct_solver != "MUMPS",
+                    ExcMessage("The direct solver MUMPS requires deal.II to "
+                               "be configured with MUMPS"));
+#endif
+
+        AssertThrow(precision == "Double" ||
+                      (type_lin == "CG" && matrix_format == "CSR"),
+                    ExcMessage("Mixed precision requires Solver type CG and "
+                               "Matrix format CSR"));
+      }
+      prm.leave_subsection();
+    }
+
+
+
+    /**
+     * @brief Monitoring: Specifies the lightweight output channels next to the
+     *        volume output, i.e., the interface surface output and the point
+     *        probes
+     */
+    struct Monitoring
+    {
+      int                              interface_output_interval;
+      bool                             matrix_layout;
+      std::vector<std::vector<double>> probe_points;
+      std::string                      probe_file;
+      std::string                      telemetry_format;
+      std::string                      trace_file;
+
+      static void
+      declare_parameters(ParameterHandler &prm);
+
+      void
+      parse_parameters(ParameterHandler &prm);
+    };
+
+    void
+    Monitoring::declare_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Monitoring");
+      {
+        prm.declare_entry("Interface output interval",
+                          "0",
+                          Patterns::Integer(0),
+                          "Write the interface surface every x timesteps, 0 "
+                          "disables the interface output");
+
+        prm.declare_entry("Matrix layout report",
+                          "false",
+                          Patterns::Bool(),
+                          "Print the bandwidth and the nonzero entries of the "
+                          "matrix and time the matrix-vector product, in "
+                          "order to compare the DoF renumberings");
+
+        prm.declare_entry("Probe points",
+                          "",
+                          Patterns::Anything(),
+                          "Points, at which the displacement, velocity and "
+                          "strain are written every timestep, e.g. "
+                          "'0.6,0.2; 0.3,0.2'");
+
+        prm.declare_entry("Probe file",
+                          "probes.csv",
+                          Patterns::Anything(),
+                          "CSV file of the probes (relative to the case "
+                          "path)");
+
+        prm.declare_entry("Telemetry format",
+                          "off",
+                          Patterns::Selection("off|jsonl|csv"),
+                          "Write the timings and iteration counts of each "
+                          "coupling iteration to telemetry.jsonl or "
+                          "telemetry.csv");
+
+        prm.declare_entry("Trace file",
+                          "",
+                          Patterns::Anything(),
+                          "Record the phases of all threads and write them "
+                          "to this file in the Chrome trace format (relative "
+                          "to the case path), empty disables the tracing");
+      }
+      prm.leave_subsection();
+    }
+
+    void
+    Monitoring::parse_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Monitoring");
+      {
+        interface_output_interval =
+          prm.get_integer("Interface output interval");
+        matrix_layout    = prm.get_bool("Matrix layout report");
+        probe_file       = prm.get("Probe file");
+        telemetry_format = prm.get("Telemetry format");
+        trace_file       = prm.get("Trace file");
+
+        probe_points.clear();
+        for (const auto &point :
+             Utilities::split_string_list(prm.get("Probe points"), ';'))
+          {
+            probe_points.emplace_back();
+            for (const auto &coordinate : Utilities::split_string_list(point))
+              probe_points.back().push_back(
+                Utilities::string_to_double(coordinate));
+          }
+      }
+      prm.leave_subsection();
+    }
+
+
+
+    /**
+     * @brief Checkpointing: Specifies the restart files, from which an
+     *        interrupted simulation can be resumed
+     */
+    struct Checkpointing
+    {
+      int         checkpoint_interval;
+      std::string checkpoint_file;
+      bool        resume;
+
+      static void
+      declare_parameters(ParameterHandler &prm);
+
+      void
+      parse_parameters(ParameterHandler &prm);
+    };
+
+    void
+    Checkpointing::declare_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Checkpointing");
+      {
+        prm.declare_entry("Checkpoint interval",
+                          "0",
+                          Patterns::Integer(0),
+                          "Write the restart file every x timesteps, 0 "
+                          "disables the checkpointing");
+
+        prm.declare_entry("Checkpoint file",
+                          "restart.bin",
+                          Patterns::Anything(),
+                          "Restart file (relative to the case path)");
+
+        prm.declare_entry("Resume",
+                          "false",
+                          Patterns::Bool(),
+                          "Resume the simulation from the restart file");
+      }
+      prm.leave_subsection();
+    }
+
+    void
+    Checkpointing::parse_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Checkpointing");
+      {
+        checkpoint_interval = prm.get_integer("Checkpoint interval");
+        checkpoint_file     = prm.get("Checkpoint file");
+        resume              = prm.get_bool("Resume");
       }
       prm.leave_subsection();
     }
@@ -218,6 +507,8 @@ namespace Linear_Elasticity
                            public Discretization,
                            public System,
                            public Time,
+                           public Monitoring,
+                           public Checkpointing,
                            public PreciceAdapterConfiguration
 
     {
@@ -249,6 +540,8 @@ namespace Linear_Elasticity
       Discretization::declare_parameters(prm);
       System::declare_parameters(prm);
       Time::declare_parameters(prm);
+      Monitoring::declare_parameters(prm);
+      Checkpointing::declare_parameters(prm);
       PreciceAdapterConfiguration::declare_parameters(prm);
     }
 
@@ -259,6 +552,8 @@ namespace Linear_Elasticity
       Discretization::parse_parameters(prm);
       System::parse_parameters(prm);
       Time::parse_parameters(prm);
+      Monitoring::parse_parameters(prm);
+      Checkpointing::parse_parameters(prm);
       PreciceAdapterConfiguration::parse_parameters(prm);
     }
   } // namespace Parameters
@@ -4,6 +4,7 @@
 #include <deal.II/base/revision.h>
 #include <deal.II/base/tensor.h>
 #include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_handler.h>
@@ -12,6 +13,7 @@
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_system.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_cache.h>
 #include <deal.II/fe/mapping_q_eulerian.h>
 
 #include <deal.II/grid/grid_generator.h>
@@ -33,17 +35,33 @@
 #include <deal.II/numerics/matrix_tools.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <map>
 
 #include "../adapter/adapter.h"
+#include "../adapter/cached_data_out.h"
+#include "../adapter/checkpoint.h"
+#include "../adapter/deflated_cg.h"
+#include "../adapter/dof_renumbering.h"
+#include "../adapter/interface_output.h"
+#include "../adapter/mixed_precision_solver.h"
+#include "../adapter/node_block_sparse_matrix.h"
+#include "../adapter/output_writer.h"
+#include "../adapter/point_probes.h"
 #include "../adapter/q_equidistant.h"
+#include "../adapter/sparse_direct_solver.h"
+#include "../adapter/telemetry.h"
 #include "../adapter/time.h"
+#include "../adapter/time_series_writer.h"
+#include "../adapter/trace.h"
 #include "include/parameter_handling.h"
 #include "include/postprocessor.h"
 
 // The Linear_Elasticity case includes a linear elastic material with a one-step
-// theta time integration
+// theta time integration or a generalized-alpha time integration
 namespace Linear_Elasticity
 {
   using namespace dealii;
@@ -52,7 +70,8 @@ namespace Linear_Elasticity
   class ElastoDynamics
   {
   public:
-    ElastoDynamics(const std::string &case_path);
+    ElastoDynamics(const std::string &case_path,
+                   const std::string &parameter_file);
     ~ElastoDynamics();
     // As usual in dealii, the run function covers the main time loop of the
     // system
@@ -72,26 +91,124 @@ namespace Linear_Elasticity
     void
     assemble_system();
 
-    // Assemble the Neumann contribution i.e. the coupling data obtained from
-    // the Fluid participant
+    // Read the coupling data obtained from the Fluid participant at all
+    // interface quadrature points
     void
-    assemble_rhs();
+    read_interface_load();
+
+    // Assemble the right-hand side, i.e., the Neumann contribution of the
+    // coupling data and the contributions of the previous time step. If
+    // history_only is set, the coupling data of the new time step is left out
+    // and the stored load of the previous time step is not updated
+    void
+    assemble_rhs(const bool history_only = false);
 
     // Solve the linear system
     void
     solve();
 
-    // Update the displacement according to the theta scheme
+    // Factorize the system_matrix for the direct solver or copy it into the
+    // node blocked or single precision format
+    void
+    initialize_linear_solver();
+
+    // Solve the system_matrix for a given right-hand side. The linear solver
+    // needs to be initialized beforehand
+    std::pair<unsigned int, double>
+    solve_linear_system(Vector<double> &solution, const Vector<double> &rhs);
+
+    // Run the (deflated) CG solver for the given matrix format
+    template <typename MatrixType, typename PreconditionerType>
+    void
+    solve_iterative(const MatrixType &        matrix,
+                    const PreconditionerType &preconditioner,
+                    Vector<double> &          solution,
+                    const Vector<double> &    rhs,
+                    SolverControl &           solver_control);
+
+    // Precompute the response of the solution on the interface DoFs to unit
+    // loads at the interface quadrature points
+    void
+    assemble_influence_matrix();
+
+    // Solve for the contributions of the previous time step, which are the
+    // same for all coupling iterations of a time step
+    void
+    compute_history_response();
+
+    // Evaluate the interface displacement of the current coupling iteration
+    // using the influence matrix
+    void
+    evaluate_interface_response();
+
+    // Update the displacement according to the theta scheme or the
+    // displacement, velocity and acceleration according to the
+    // generalized-alpha scheme
     void
     update_displacement();
 
-    // Output results to vtk files
+    // Factors of the mass and the stiffness matrix in the time stepping
+    // operator A = mass_factor * M + stiffness_factor * K
+    double
+    mass_factor() const;
+
+    double
+    stiffness_factor() const;
+
+#ifdef DEBUG
+    // Compare the right-hand side with its formulation in terms of the mass
+    // matrix, i.e., forces - K*d + M*v, on all DoFs, which are neither
+    // constrained nor subject to Dirichlet BCs
+    void
+    check_rhs(const Vector<double> &forces,
+              const Vector<double> &d,
+              const Vector<double> &v) const;
+#endif
+
+    // The unknown of the linear system: the velocity for the theta scheme and
+    // the displacement increment for the generalized-alpha scheme
+    Vector<double> &
+    solution_vector();
+
+    // Subdivisions of each cell in the output
+    unsigned int
+    n_output_subdivisions() const;
+
+    // Write the probes and, if requested, the interface surface including the
+    // coupling data
+    void
+    output_monitoring() const;
+
+    // Output results to vtk files. Only a snapshot of the displacement is
+    // taken here, the files are written in the background
     void
     output_results() const;
 
+    // Write the restart file in the background
+    void
+    write_checkpoint() const;
+
+    // Read the time and the state variables from the restart file. The
+    // triangulation and the DoF numbering are read in make_grid() and
+    // setup_system()
+    void
+    load_checkpoint();
+
     // Paramter class parsing all user specific input parameters
     const Parameters::AllParameters parameters;
 
+    // Newmark coefficients of the generalized-alpha scheme, which are needed
+    // for time dependencies (constant time step size)
+    const double alpha_1 =
+      1. / (parameters.beta * parameters.delta_t * parameters.delta_t);
+    const double alpha_2 = 1. / (parameters.beta * parameters.delta_t);
+    const double alpha_3 = (1 - 2 * parameters.beta) / (2 * parameters.beta);
+    const double alpha_4 =
+      parameters.gamma / (parameters.beta * parameters.delta_t);
+    const double alpha_5 = 1 - parameters.gamma / parameters.beta;
+    const double alpha_6 =
+      (1 - parameters.gamma / (2 * parameters.beta)) * parameters.delta_t;
+
     // Boundary IDs, reserved for the respectve application
     unsigned int       clamped_mesh_id;
     unsigned int       out_of_plane_clamped_mesh_id;
@@ -106,12 +223,17 @@ namespace Linear_Elasticity
 
     AffineConstraints<double> hanging_node_constraints;
 
-    // Matrices used during computations
+    // Matrices used during computations: the system_matrix holds the time
+    // stepping operator (a combination of mass and stiffness matrix) with the
+    // constraints and Dirichlet BCs applied. It does not change and replaces
+    // the mass matrix in the right-hand side as well (see assemble_rhs())
     SparsityPattern      sparsity_pattern;
-    SparseMatrix<double> mass_matrix;
     SparseMatrix<double> stiffness_matrix;
     SparseMatrix<double> system_matrix;
-    SparseMatrix<double> stepping_matrix;
+#ifdef DEBUG
+    // The mass matrix is only kept in debug mode to verify the right-hand side
+    SparseMatrix<double> mass_matrix;
+#endif
 
     // Time dependent variables
     Vector<double> old_velocity;
@@ -121,13 +243,67 @@ namespace Linear_Elasticity
     Vector<double> old_stress;
     Vector<double> system_rhs;
 
+    // Additional variables of the generalized-alpha scheme
+    Vector<double> acceleration;
+    Vector<double> displacement_increment;
+
+    // Dirichlet boundary values, which are the same in every time step
+    std::map<types::global_dof_index, double> boundary_values;
+
+    // Coupling data at all interface quadrature points (dim values per point)
+    Vector<double> interface_load;
+
+    // Interface influence matrix: the solution of the linear system on the
+    // interface DoFs is the history response plus the influence matrix times
+    // the interface load. The history response is only valid for the time
+    // step it has been computed for
+    std::vector<types::global_dof_index> interface_dofs;
+    FullMatrix<double>                   influence_matrix;
+    Vector<double>                       interface_history;
+    unsigned int                         history_timestep;
+    // Displacement passed to the Adapter during the coupling iterations, of
+    // which only the interface DoFs are updated
+    Vector<double> interface_displacement;
+
     // Body forces e.g. gravity. Values are specified in the input file
     const bool     body_force_enabled;
     Vector<double> body_force_vector;
 
+    // Direct solver, which reuses the symbolic factorization in each time step
+    Adapter::SparseDirectSolver direct_solver;
+
+    // Deflated CG, which recycles the solutions of previous time steps
+    Adapter::DeflatedCG deflated_cg;
+
+    // Copy of the system_matrix in node blocked format for the iterative
+    // solvers
+    Adapter::NodeBlockSparseMatrix<dim> node_block_matrix;
+
+    // Single precision copy of the system_matrix for the mixed precision CG
+    Adapter::MixedPrecisionSolver mixed_precision_solver;
+
+    // Writes the result files in the selected format (in the background)
+    mutable Adapter::TimeSeriesWriter<dim> time_series_writer;
+    mutable Adapter::OutputWriter          output_writer;
+
+    // Output patches on the reference configuration, which are built once
+    std::unique_ptr<Adapter::CachedDataOut<dim>> reference_output;
+
+    // Lightweight output channels for monitoring
+    mutable Adapter::TimeSeriesWriter<dim - 1, dim> interface_writer;
+    std::unique_ptr<Adapter::PointProbes<dim>>      probes;
+
+    // The restart file is read during the setup, if the simulation is
+    // resumed, and written in the background
+    std::unique_ptr<Adapter::CheckpointIn> restart;
+    mutable Adapter::OutputWriter          checkpoint_writer;
+
     // In order to measure some timings
     mutable TimerOutput timer;
 
+    // Timings and iteration counts of each coupling iteration
+    Adapter::Telemetry telemetry;
+
     // The main adapter objects: The time class keeps track of the current time
     // and time steps. The Adapter class includes all functionalities for
     // coupling via preCICE. Look at the documentation of the class for more
@@ -147,16 +323,37 @@ namespace Linear_Elasticity
 
   // Constructor
   template <int dim>
-  ElastoDynamics<dim>::ElastoDynamics(const std::string &case_path)
-    : parameters(case_path + "linear_elasticity.prm")
+  ElastoDynamics<dim>::ElastoDynamics(const std::string &case_path,
+                                      const std::string &parameter_file)
+    : parameters(parameter_file)
     , interface_boundary_id(6)
     , dof_handler(triangulation)
     , fe(FE_Q<dim>(parameters.poly_degree), dim)
     , mapping(
         std::make_shared<const MappingQGeneric<dim>>(parameters.poly_degree))
     , quad_order(parameters.poly_degree + 1)
+    , history_timestep(numbers::invalid_unsigned_int)
     , body_force_enabled(parameters.body_force.norm() > 1e-15)
+    , direct_solver(parameters.direct_solver)
+    , deflated_cg(parameters.deflation_vectors, true)
+    , time_series_writer(parameters.output_format, case_path)
+    , output_writer(time_series_writer.supports_concurrent_writes() ?
+                      parameters.output_queue_depth :
+                      0)
+    , interface_writer(parameters.output_format, case_path, "interface")
+    , checkpoint_writer(1)
     , timer(std::cout, TimerOutput::summary, TimerOutput::wall_times)
+    , telemetry(parameters.telemetry_format,
+                case_path + "telemetry." + parameters.telemetry_format,
+                {"Assemble rhs",
+                 "Solve system",
+                 "Write coupling data",
+                 "preCICE advance",
+                 "Save state",
+                 "Reload state",
+                 "Output results",
+                 "Write checkpoint"},
+                {"linear_iterations"})
     , time(parameters.end_time, parameters.delta_t)
     , adapter(parameters, interface_boundary_id, false)
     , case_path(case_path)
@@ -177,72 +374,7 @@ namespace Linear_Elasticity
   void
   ElastoDynamics<dim>::make_grid()
   {
-    uint n_x, n_y, n_z;
-
-    // Both preconfigured cases consist of a rectangle
-    Point<dim> point_bottom;
-    Point<dim> point_tip;
-
-    // boundary IDs are obtained through colorize = true
-    uint id_flap_long_bottom, id_flap_long_top, id_flap_short_bottom,
-      id_flap_short_top, id_flap_out_of_plane_bottom, id_flap_out_of_plane_top;
-
-    // Hron & Turek FSI3 case
-    if (parameters.scenario == "FSI3")
-      {
-        // FSI 3
-        n_x          = 18;
-        n_y          = 3;
-        n_z          = 1;
-        point_bottom = dim == 3 ? Point<dim>(0.24899, 0.19, -0.005) :
-                                  Point<dim>(0.24899, 0.19);
-        point_tip =
-          dim == 3 ? Point<dim>(0.6, 0.21, 0.005) : Point<dim>(0.6, 0.21);
-
-        // IDs for FSI3
-        id_flap_long_bottom  = 2; // x direction
-        id_flap_long_top     = 3;
-        id_flap_short_bottom = 0; // y direction
-        id_flap_short_top    = 1;
-      }
-    else
-      {
-        // Flap_perp case
-        n_x = 3;
-        n_y = 18;
-        n_z = 1;
-        point_bottom =
-          dim == 3 ? Point<dim>(-0.05, 0, 0) : Point<dim>(-0.05, 0);
-        point_tip = dim == 3 ? Point<dim>(0.05, 1, 0.3) : Point<dim>(0.05, 1);
-
-        // IDs for PF
-        id_flap_long_bottom  = 0; // x direction
-        id_flap_long_top     = 1;
-        id_flap_short_bottom = 2; // y direction
-        id_flap_short_top    = 3;
-      }
-
-    // Same for both scenarios, only relevant for quasi-2D
-    id_flap_out_of_plane_bottom = 4; // z direction
-    id_flap_out_of_plane_top    = 5;
-
-    // Vector of dim values denoting the number of cells to generate in that
-    // direction
-    const std::vector<unsigned int> repetitions =
-      dim == 2 ? std::vector<unsigned int>({n_x, n_y}) :
-                 std::vector<unsigned int>({n_x, n_y, n_z});
-
-    GridGenerator::subdivided_hyper_rectangle(triangulation,
-                                              repetitions,
-                                              point_bottom,
-                                              point_tip,
-                                              /*colorize*/ true);
-
-    // Refine all cells global_refinement times
-    const unsigned int global_refinement = 0;
-    triangulation.refine_global(global_refinement);
-
-    // Set the desired IDs for clamped boundaries and out_of_plane clamped
+    // The desired IDs for clamped boundaries and out_of_plane clamped
     // boundaries. The interface ID (refering to the coupling) is specified in
     // the Constructor, since it is needed by the Constructor of the Adapter
     // class.
@@ -259,24 +391,110 @@ namespace Linear_Elasticity
     AssertThrow(interface_boundary_id == adapter.dealii_boundary_interface_id,
                 ExcMessage("Wrong interface ID in the Adapter specified"));
 
-    // Iterate over all cells and set the IDs
-    for (const auto &cell : triangulation.active_cell_iterators())
-      for (const auto &face : cell->face_iterators())
-        if (face->at_boundary() == true)
+    // When resuming, the triangulation including the boundary IDs is taken
+    // from the restart file
+    if (restart)
+      restart->load_triangulation(triangulation);
+    else
+      {
+        uint n_x, n_y, n_z;
+
+        // Both preconfigured cases consist of a rectangle
+        Point<dim> point_bottom;
+        Point<dim> point_tip;
+
+        // boundary IDs are obtained through colorize = true
+        uint id_flap_long_bottom, id_flap_long_top, id_flap_short_bottom,
+          id_flap_short_top, id_flap_out_of_plane_bottom,
+          id_flap_out_of_plane_top;
+
+        // Hron & Turek FSI3 case
+        if (parameters.scenario == "FSI3")
+          {
+            // FSI 3
+            n_x          = 18;
+            n_y          = 3;
+            n_z          = 1;
+            point_bottom = dim == 3 ? Point<dim>(0.24899, 0.19, -0.005) :
+                                      Point<dim>(0.24899, 0.19);
+            point_tip =
+              dim == 3 ? Point<dim>(0.6, 0.21, 0.005) : Point<dim>(0.6, 0.21);
+
+            // IDs for FSI3
+            id_flap_long_bottom  = 2; // x direction
+            id_flap_long_top     = 3;
+            id_flap_short_bottom = 0; // y direction
+            id_flap_short_top    = 1;
+          }
+        else
           {
-            // Boundaries for the interface
-            if (face->boundary_id() == id_flap_short_top ||
-                face->boundary_id() == id_flap_long_bottom ||
-                face->boundary_id() == id_flap_long_top)
-              face->set_boundary_id(interface_boundary_id);
-            // Boundaries clamped in all directions
-            else if (face->boundary_id() == id_flap_short_bottom)
-              face->set_boundary_id(clamped_mesh_id);
-            // Boundaries clamped out-of-plane (z) direction
-            else if (face->boundary_id() == id_flap_out_of_plane_bottom ||
-                     face->boundary_id() == id_flap_out_of_plane_top)
-              face->set_boundary_id(out_of_plane_clamped_mesh_id);
+            // Flap_perp case
+            n_x = 3;
+            n_y = 18;
+            n_z = 1;
+            point_bottom =
+              dim == 3 ? Point<dim>(-0.05, 0, 0) : Point<dim>(-0.05, 0);
+            point_tip =
+              dim == 3 ? Point<dim>(0.05, 1, 0.3) : Point<dim>(0.05, 1);
+
+            // IDs for PF
+            id_flap_long_bottom  = 0; // x direction
+            id_flap_long_top     = 1;
+            id_flap_short_bottom = 2; // y direction
+            id_flap_short_top    = 3;
           }
+
+        // Same for both scenarios, only relevant for quasi-2D
+        id_flap_out_of_plane_bottom = 4; // z direction
+        id_flap_out_of_plane_top    = 5;
+
+        // Vector of dim values denoting the number of cells to generate in
+        // that direction
+        const std::vector<unsigned int> repetitions =
+          dim == 2 ? std::vector<unsigned int>({n_x, n_y}) :
+                     std::vector<unsigned int>({n_x, n_y, n_z});
+
+        GridGenerator::subdivided_hyper_rectangle(triangulation,
+                                                  repetitions,
+                                                  point_bottom,
+                                                  point_tip,
+                                                  /*colorize*/ true);
+
+        // Refine all cells global_refinement times
+        const unsigned int global_refinement = 0;
+        triangulation.refine_global(global_refinement);
+
+        // Iterate over all cells and set the IDs
+        for (const auto &cell : triangulation.active_cell_iterators())
+          for (const auto &face : cell->face_iterators())
+            if (face->at_boundary() == true)
+              {
+                // Boundaries for the interface
+                if (face->boundary_id() == id_flap_short_top ||
+                    face->boundary_id() == id_flap_long_bottom ||
+                    face->boundary_id() == id_flap_long_top)
+                  face->set_boundary_id(interface_boundary_id);
+                // Boundaries clamped in all directions
+                else if (face->boundary_id() == id_flap_short_bottom)
+                  face->set_boundary_id(clamped_mesh_id);
+                // Boundaries clamped out-of-plane (z) direction
+                else if (face->boundary_id() == id_flap_out_of_plane_bottom ||
+                         face->boundary_id() == id_flap_out_of_plane_top)
+                  face->set_boundary_id(out_of_plane_clamped_mesh_id);
+              }
+      }
+
+    // The reference configuration does not change, so that the support points
+    // of the high order mapping can be computed once for all cells. All
+    // subsequent reinit() calls of FEValues and FEFaceValues, in the solver
+    // and in the Adapter, look them up instead of recomputing them
+    if (parameters.mapping_cache)
+      {
+        auto mapping_cache =
+          std::make_shared<MappingQCache<dim>>(parameters.poly_degree);
+        mapping_cache->initialize(triangulation, *mapping);
+        mapping = mapping_cache;
+      }
   }
 
 
@@ -287,6 +505,16 @@ namespace Linear_Elasticity
   {
     // This follows the usual dealii steps
     dof_handler.distribute_dofs(fe);
+    // When resuming, the DoFs are numbered as in the restart file, such that
+    // the stored vectors can be read directly
+    if (restart)
+      restart->load_dof_numbering(dof_handler);
+    else
+      {
+        Adapter::renumber_dofs(dof_handler, parameters.dof_renumbering);
+        if (parameters.matrix_format == "Node-blocked")
+          Adapter::make_node_contiguous(dof_handler);
+      }
     hanging_node_constraints.clear();
     DoFTools::make_hanging_node_constraints(dof_handler,
                                             hanging_node_constraints);
@@ -300,10 +528,22 @@ namespace Linear_Elasticity
     sparsity_pattern.copy_from(dsp);
 
     // Initialize relevant matrices
-    mass_matrix.reinit(sparsity_pattern);
     stiffness_matrix.reinit(sparsity_pattern);
     system_matrix.reinit(sparsity_pattern);
-    stepping_matrix.reinit(sparsity_pattern);
+#ifdef DEBUG
+    mass_matrix.reinit(sparsity_pattern);
+#endif
+    if (parameters.matrix_format == "Node-blocked")
+      {
+        node_block_matrix.reinit(sparsity_pattern);
+        // The block format is a copy of the system_matrix, which is kept
+        std::cout << "\t Node blocked matrix: "
+                  << node_block_matrix.memory_consumption()
+                  << " bytes in addition to the CSR matrix ("
+                  << system_matrix.memory_consumption() +
+                       sparsity_pattern.memory_consumption()
+                  << " bytes)" << std::endl;
+      }
 
     // Initialize all vectors
     old_velocity.reinit(dof_handler.n_dofs());
@@ -315,9 +555,91 @@ namespace Linear_Elasticity
     system_rhs.reinit(dof_handler.n_dofs());
     old_stress.reinit(dof_handler.n_dofs());
 
+    acceleration.reinit(dof_handler.n_dofs());
+    displacement_increment.reinit(dof_handler.n_dofs());
+
+    // Set Dirichlet BCs:
+    // clamped in all directions
+    boundary_values.clear();
+    VectorTools::interpolate_boundary_values(dof_handler,
+                                             clamped_mesh_id,
+                                             Functions::ZeroFunction<dim>(dim),
+                                             boundary_values);
+    if (dim == 3)
+      {
+        const FEValuesExtractors::Scalar z_component(2);
+        // clamped out_of_plane
+        VectorTools::interpolate_boundary_values(
+          dof_handler,
+          out_of_plane_clamped_mesh_id,
+          Functions::ZeroFunction<dim>(dim),
+          boundary_values,
+          fe.component_mask(z_component));
+      }
+
+    // The coupling data is read at the face quadrature points of the
+    // interface. The interface DoFs are all DoFs on the interface faces, which
+    // determine the displacement passed to the Adapter
+    const unsigned int n_face_q_points = QGauss<dim - 1>(quad_order).size();
+    unsigned int       n_interface_points = 0;
+
+    std::vector<types::global_dof_index> face_dof_indices(fe.dofs_per_face);
+    interface_dofs.clear();
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      for (const auto &face : cell->face_iterators())
+        if (face->at_boundary() == true &&
+            face->boundary_id() == interface_boundary_id)
+          {
+            n_interface_points += n_face_q_points;
+            face->get_dof_indices(face_dof_indices);
+            interface_dofs.insert(interface_dofs.end(),
+                                  face_dof_indices.begin(),
+                                  face_dof_indices.end());
+          }
+    std::sort(interface_dofs.begin(), interface_dofs.end());
+    interface_dofs.erase(std::unique(interface_dofs.begin(),
+                                     interface_dofs.end()),
+                         interface_dofs.end());
+
+    interface_load.reinit(n_interface_points * dim);
+    if (parameters.interface_influence)
+      {
+        interface_history.reinit(interface_dofs.size());
+        interface_displacement.reinit(dof_handler.n_dofs());
+      }
+
     if (body_force_enabled)
       body_force_vector.reinit(dof_handler.n_dofs());
 
+    if (parameters.output_geometry == "Reference" ||
+        time_series_writer.reference_geometry())
+      reference_output = std::make_unique<Adapter::CachedDataOut<dim>>(
+        dof_handler,
+        *mapping,
+        std::make_shared<Postprocessor<dim>>(),
+        n_output_subdivisions());
+
+    if (!parameters.probe_points.empty())
+      {
+        std::vector<Point<dim>> points;
+        for (const auto &coordinates : parameters.probe_points)
+          {
+            AssertThrow(coordinates.size() == dim,
+                        ExcMessage("The probe points need to have " +
+                                   std::to_string(dim) + " coordinates"));
+            Point<dim> point;
+            for (unsigned int d = 0; d < dim; ++d)
+              point[d] = coordinates[d];
+            points.push_back(point);
+          }
+        probes = std::make_unique<Adapter::PointProbes<dim>>(
+          dof_handler,
+          *mapping,
+          points,
+          case_path + parameters.probe_file,
+          /*append = */ parameters.resume);
+      }
+
     std::cout.imbue(std::locale(""));
     std::cout << "Triangulation:"
               << "\n\t Number of active cells: "
@@ -325,10 +647,20 @@ namespace Linear_Elasticity
               << "\n\t Polynomial degree: " << parameters.poly_degree
               << "\n\t Number of degrees of freedom: " << dof_handler.n_dofs()
               << std::endl;
+    std::cout << "Time integration: " << parameters.time_integration;
+    if (parameters.time_integration == "Generalized-alpha")
+      std::cout << " (spectral radius " << parameters.spectral_radius << ")";
+    else
+      std::cout << " (theta " << parameters.theta << ")";
+    std::cout << std::endl;
 
     // Define alias for time dependent variables as described above
-    state_variables = {
-      &old_velocity, &velocity, &old_displacement, &displacement, &old_stress};
+    state_variables = {&old_velocity,
+                       &velocity,
+                       &old_displacement,
+                       &displacement,
+                       &old_stress,
+                       &acceleration};
 
     // loads at time 0
     // TODO: Check, if initial conditions should be set at the beginning
@@ -363,10 +695,45 @@ namespace Linear_Elasticity
     Functions::ConstantFunction<dim> lambda(parameters.lambda),
       mu(parameters.mu);
 
+    // The Lame constants are the same for all cells and the manifold of the
+    // flap is flat. Hence, two cells have the same local matrix, if their
+    // vertices are translated copies of each other. The cells are identified
+    // by their vertex offsets relative to the first vertex, rounded to a small
+    // fraction of the cell diameter. Each distinct cell matrix is computed
+    // once, which makes the assembly on the structured meshes of the
+    // preconfigured cases a pure scatter. On unstructured meshes, where
+    // hardly any cell matches another one, the number of cached matrices is
+    // limited and the remaining cells are computed as usual.
+    const unsigned int max_cached_matrices = 64;
+    const double       key_tolerance       = 1e-8;
+
+    std::map<std::vector<long long>, FullMatrix<double>> cell_matrix_cache;
+
+    std::vector<long long> cell_key(GeometryInfo<dim>::vertices_per_cell * dim);
+    unsigned int           n_reused_matrices = 0;
+
     // Assemble the stiffness matrix according to a linear material law using
     // the lame paramters
     for (const auto &cell : dof_handler.active_cell_iterators())
       {
+        cell->get_dof_indices(local_dof_indices);
+
+        const double scale = key_tolerance * cell->diameter();
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          for (unsigned int d = 0; d < dim; ++d)
+            cell_key[v * dim + d] =
+              std::llround((cell->vertex(v)[d] - cell->vertex(0)[d]) / scale);
+
+        const auto cached_matrix = cell_matrix_cache.find(cell_key);
+        if (cached_matrix != cell_matrix_cache.end())
+          {
+            // The row-wise addition looks up the column indices of a row
+            // together, instead of searching each entry separately
+            stiffness_matrix.add(local_dof_indices, cached_matrix->second);
+            ++n_reused_matrices;
+            continue;
+          }
+
         cell_matrix = 0;
 
         fe_values.reinit(cell);
@@ -415,36 +782,74 @@ namespace Linear_Elasticity
           }
 
 
+        if (cell_matrix_cache.size() < max_cached_matrices)
+          cell_matrix_cache.emplace(cell_key, cell_matrix);
+
         // The transfer from local degrees of freedom into the global matrix
-        cell->get_dof_indices(local_dof_indices);
-        for (unsigned int i = 0; i < dofs_per_cell; ++i)
-          {
-            for (unsigned int j = 0; j < dofs_per_cell; ++j)
-              stiffness_matrix.add(local_dof_indices[i],
-                                   local_dof_indices[j],
-                                   cell_matrix(i, j));
-          }
+        stiffness_matrix.add(local_dof_indices, cell_matrix);
       }
 
+    std::cout << "\t Reused cell matrices: " << n_reused_matrices << " of "
+              << triangulation.n_active_cells() << " cells" << std::endl;
+
 
-    // Here, we use the MatrixCreator to create a mass matrix, which is constant
-    // through the whole simulation
+    // Here, we use the MatrixCreator to create the mass matrix directly in
+    // the system_matrix, which is then combined with the stiffness matrix to
+    // the time stepping operator. The mass matrix is not stored separately
     {
       Functions::ConstantFunction<dim> rho_f(parameters.rho);
 
       MatrixCreator::create_mass_matrix(
-        *mapping, dof_handler, QGauss<dim>(quad_order), mass_matrix, &rho_f);
+        *mapping, dof_handler, QGauss<dim>(quad_order), system_matrix, &rho_f);
     }
+#ifdef DEBUG
+    mass_matrix.copy_from(system_matrix);
+#endif
 
-    // Then, we save the system_matrix, which is needed every timestep
-    stepping_matrix.copy_from(stiffness_matrix);
+    // A = mass_factor * M + stiffness_factor * K
+    system_matrix *= mass_factor();
+    system_matrix.add(stiffness_factor(), stiffness_matrix);
 
-    stepping_matrix *= time.get_delta_t() * time.get_delta_t() *
-                       parameters.theta * parameters.theta;
+    hanging_node_constraints.condense(system_matrix);
 
-    stepping_matrix.add(1, mass_matrix);
+    // The Dirichlet BCs are homogeneous, so that they can be applied once to
+    // the operator. The right-hand side only needs to vanish on the
+    // constrained DoFs in each time step (see assemble_rhs())
+    {
+      Vector<double> solution(dof_handler.n_dofs());
+      Vector<double> rhs(dof_handler.n_dofs());
+      for (const auto &boundary_value : boundary_values)
+        AssertThrow(boundary_value.second == 0.,
+                    ExcMessage("Only homogeneous Dirichlet BCs are "
+                               "supported"));
+
+      MatrixTools::apply_boundary_values(boundary_values,
+                                         system_matrix,
+                                         solution,
+                                         rhs);
+    }
 
-    hanging_node_constraints.condense(stepping_matrix);
+    // The operator is constant, so that the linear solver is set up only once
+    initialize_linear_solver();
+
+    // Report the memory of the matrices and the peak memory of the process,
+    // which is reached during the assembly
+    {
+      const double n_dofs = dof_handler.n_dofs();
+
+      Utilities::System::MemoryStats memory_stats;
+      Utilities::System::get_memory_stats(memory_stats);
+
+      std::cout << "\t Matrix memory per DoF: "
+                << (sparsity_pattern.memory_consumption() +
+                    stiffness_matrix.memory_consumption() +
+                    system_matrix.memory_consumption()) /
+                     n_dofs
+                << " bytes"
+                << "\n\t Peak memory per DoF: "
+                << memory_stats.VmHWM * 1024. / n_dofs << " bytes"
+                << std::endl;
+    }
 
     // Calculate contribution of gravity and store them in gravitational_force
     if (body_force_enabled)
@@ -466,11 +871,32 @@ namespace Linear_Elasticity
   }
 
 
+  // Read the coupling data in the same order as the interface quadrature
+  // points have been passed to preCICE
+  template <int dim>
+  void
+  ElastoDynamics<dim>::read_interface_load()
+  {
+    std::array<double, dim> local_stress;
+    auto                    q_index = adapter.begin_interface_IDs();
+
+    for (unsigned int point = 0; point < interface_load.size() / dim;
+         ++point, ++q_index)
+      {
+        adapter.read_on_quadrature_point(local_stress, *q_index);
+        for (unsigned int d = 0; d < dim; ++d)
+          interface_load(point * dim + d) = local_stress[d];
+      }
+  }
+
+
+
   // Process RHS assembly, which is the coupling data (stress) in this case
   template <int dim>
   void
-  ElastoDynamics<dim>::assemble_rhs()
+  ElastoDynamics<dim>::assemble_rhs(const bool history_only)
   {
+    const Adapter::TraceScope trace("Assemble rhs");
     timer.enter_subsection("Assemble rhs");
 
     // Initialize all objects as usual
@@ -491,9 +917,8 @@ namespace Linear_Elasticity
     std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
 
 
-    // In order to get the local fe values
-    std::array<double, dim> local_stress;
-    auto                    q_index = adapter.begin_interface_IDs();
+    // Index of the interface quadrature point in interface_load
+    unsigned int point_index = 0;
 
     for (const auto &cell : dof_handler.active_cell_iterators())
       {
@@ -502,7 +927,7 @@ namespace Linear_Elasticity
         // Assemble the right-hand side force vector each timestep
         // by applying contributions only on the coupling interface
         for (const auto &face : cell->face_iterators())
-          if (face->at_boundary() == true &&
+          if (history_only == false && face->at_boundary() == true &&
               face->boundary_id() == interface_boundary_id)
             {
               fe_face_values.reinit(cell, face);
@@ -513,8 +938,6 @@ namespace Linear_Elasticity
               for (const auto f_q_point :
                    fe_face_values.quadrature_point_indices())
                 {
-                  adapter.read_on_quadrature_point(local_stress, *q_index);
-                  ++q_index;
                   for (unsigned int i = 0; i < dofs_per_cell; ++i)
                     {
                       const unsigned int component_i =
@@ -522,10 +945,12 @@ namespace Linear_Elasticity
 
                       AssertIndexRange(component_i, dim);
 
-                      cell_rhs(i) += fe_face_values.shape_value(i, f_q_point) *
-                                     local_stress[component_i] *
-                                     fe_face_values.JxW(f_q_point);
+                      cell_rhs(i) +=
+                        fe_face_values.shape_value(i, f_q_point) *
+                        interface_load(point_index * dim + component_i) *
+                        fe_face_values.JxW(f_q_point);
                     }
+                  ++point_index;
                 }
             }
 
@@ -548,6 +973,11 @@ namespace Linear_Elasticity
     // Assemble global RHS:
     // RHS=(M-theta*(1-theta)*delta_t^2*K)*V_n - delta_t*K* D_n +
     // delta_t*theta*F_n+1 + delta_t*(1-theta)*F_n
+    // Since the mass matrix is not stored, the products with M are expressed
+    // by means of A = mass_factor * M + stiffness_factor * K, i.e.,
+    // M*y = (A*y - stiffness_factor * K*y) / mass_factor. The Dirichlet BCs
+    // and constraints applied to A do not alter this product, since all
+    // vectors y satisfy them.
 
     // tmp vector to store intermediate results
     Vector<double> tmp;
@@ -555,54 +985,83 @@ namespace Linear_Elasticity
 
     tmp = system_rhs;
 
-    // TODO: old_stress is a global vector, it might be better to store just the
-    // affected dofs of the boundary elements
-    system_rhs *= time.get_delta_t() * parameters.theta;
-    system_rhs.add(time.get_delta_t() * (1 - parameters.theta), old_stress);
-    old_stress = tmp;
-
-    mass_matrix.vmult(tmp, old_velocity);
-    system_rhs.add(1, tmp);
+    if (parameters.time_integration == "Generalized-alpha")
+      {
+        // RHS=(1-alpha_f)*F_n+1 + alpha_f*F_n - K*D_n +
+        // M*((1-alpha_m)*(alpha_2*V_n + alpha_3*A_n) - alpha_m*A_n)
+        system_rhs *= 1 - parameters.alpha_f;
+        system_rhs.add(parameters.alpha_f, old_stress);
+        if (!history_only)
+          old_stress = tmp;
+#ifdef DEBUG
+        const Vector<double> forces(system_rhs);
+#endif
 
-    stiffness_matrix.vmult(tmp, old_velocity);
-    system_rhs.add(-parameters.theta * time.get_delta_t() * time.get_delta_t() *
-                     (1 - parameters.theta),
-                   tmp);
+        // M*y with y = (1-alpha_m)*(alpha_2*V_n + alpha_3*A_n) - alpha_m*A_n
+        Vector<double> y(dof_handler.n_dofs());
+        y.equ((1 - parameters.alpha_m) * alpha_2, old_velocity);
+        y.add((1 - parameters.alpha_m) * alpha_3 - parameters.alpha_m,
+              acceleration);
 
-    stiffness_matrix.vmult(tmp, old_displacement);
-    system_rhs.add(-time.get_delta_t(), tmp);
+        // -K*(D_n + stiffness_factor / mass_factor * y)
+        Vector<double> z(old_displacement);
+        z.add(stiffness_factor() / mass_factor(), y);
+        stiffness_matrix.vmult(tmp, z);
+        system_rhs.add(-1, tmp);
 
-    hanging_node_constraints.condense(system_rhs);
+        hanging_node_constraints.condense(system_rhs);
 
-    // Copy the system_matrix every timestep, since applying the BC deletes
-    // certain rows and columns
-    // TODO: Check this again
-    system_matrix = 0.0;
-    system_matrix.copy_from(stepping_matrix);
+        // A*y / mass_factor
+        system_matrix.vmult(tmp, y);
+        system_rhs.add(1. / mass_factor(), tmp);
 
-    // Set Dirichlet BCs:
-    // clamped in all directions
-    std::map<types::global_dof_index, double> boundary_values;
-    VectorTools::interpolate_boundary_values(dof_handler,
-                                             clamped_mesh_id,
-                                             Functions::ZeroFunction<dim>(dim),
-                                             boundary_values);
-    if (dim == 3)
+#ifdef DEBUG
+        check_rhs(forces, old_displacement, y);
+#endif
+      }
+    else
       {
-        const FEValuesExtractors::Scalar z_component(2);
-        // clamped out_of_plane
-        VectorTools::interpolate_boundary_values(
-          dof_handler,
-          out_of_plane_clamped_mesh_id,
-          Functions::ZeroFunction<dim>(dim),
-          boundary_values,
-          fe.component_mask(z_component));
+        // TODO: old_stress is a global vector, it might be better to store
+        // just the affected dofs of the boundary elements
+        system_rhs *= time.get_delta_t() * parameters.theta;
+        system_rhs.add(time.get_delta_t() * (1 - parameters.theta), old_stress);
+        if (!history_only)
+          old_stress = tmp;
+#ifdef DEBUG
+        const Vector<double> forces(system_rhs);
+#endif
+
+        // With A = M + theta^2*delta_t^2*K, the RHS reads
+        // A*V_n - delta_t*K*(theta*delta_t*V_n + D_n)
+        Vector<double> y(old_displacement);
+        y.add(parameters.theta * time.get_delta_t(), old_velocity);
+        stiffness_matrix.vmult(tmp, y);
+        system_rhs.add(-time.get_delta_t(), tmp);
+
+        hanging_node_constraints.condense(system_rhs);
+
+        system_matrix.vmult(tmp, old_velocity);
+        system_rhs.add(1, tmp);
+
+#ifdef DEBUG
+        // M*V_n - delta_t*K*(theta*(1-theta)*delta_t*V_n + D_n)
+        Vector<double> d(old_displacement);
+        d.add(parameters.theta * (1 - parameters.theta) * time.get_delta_t(),
+              old_velocity);
+        d *= time.get_delta_t();
+        check_rhs(forces, d, old_velocity);
+#endif
       }
 
-    MatrixTools::apply_boundary_values(boundary_values,
-                                       system_matrix,
-                                       velocity,
-                                       system_rhs);
+    // The product with A does not vanish on constrained DoFs
+    hanging_node_constraints.set_zero(system_rhs);
+
+    // Set Dirichlet BCs, which have already been applied to the system_matrix
+    for (const auto &boundary_value : boundary_values)
+      {
+        system_rhs(boundary_value.first)        = 0.;
+        solution_vector()(boundary_value.first) = 0.;
+      }
 
     timer.leave_subsection("Assemble rhs");
   }
@@ -615,61 +1074,358 @@ namespace Linear_Elasticity
   {
     timer.enter_subsection("Solve system");
 
+    // Solve the linear system either using an iterative (deflated) CG solver
+    // with SSOR or a direct solver using UMFPACK
+    std::cout << "\t " << parameters.type_lin << " solver: " << std::endl;
+
+    const std::pair<unsigned int, double> lin_solver_output =
+      solve_linear_system(solution_vector(), system_rhs);
+
+    // assert divergence
+    Assert(solution_vector().linfty_norm() < 1e4,
+           ExcMessage("Linear system diverged"));
+    std::cout << "\t     No of iterations:\t" << lin_solver_output.first
+              << "\n \t     Final residual:\t" << lin_solver_output.second
+              << std::endl;
+    hanging_node_constraints.distribute(solution_vector());
+
+    timer.leave_subsection("Solve system");
+  }
+
+
+
+  template <int dim>
+  void
+  ElastoDynamics<dim>::initialize_linear_solver()
+  {
+    if (parameters.type_lin == "Direct")
+      direct_solver.factorize(system_matrix);
+    else if (parameters.matrix_format == "Node-blocked")
+      node_block_matrix.copy_from(system_matrix);
+    else if (parameters.precision == "Mixed")
+      mixed_precision_solver.initialize(system_matrix, 1.2);
+  }
+
+
+
+  template <int dim>
+  std::pair<unsigned int, double>
+  ElastoDynamics<dim>::solve_linear_system(Vector<double> &      solution,
+                                           const Vector<double> &rhs)
+  {
+    const Adapter::TraceScope trace("Solve linear system");
+
     uint   lin_it  = 1;
     double lin_res = 0.0;
 
-    // Solve the linear system either using an iterative CG solver with SSOR or
-    // a direct solver using UMFPACK
-    if (parameters.type_lin == "CG")
+    if (parameters.type_lin == "CG" || parameters.type_lin == "Deflated CG")
       {
-        std::cout << "\t CG solver: " << std::endl;
-
         const int solver_its =
           system_matrix.m() * parameters.max_iterations_lin;
-        const double tol_sol = parameters.tol_lin * system_rhs.l2_norm();
+        const double tol_sol = parameters.tol_lin * rhs.l2_norm();
 
-        SolverControl         solver_control(solver_its, tol_sol);
-        GrowingVectorMemory<> GVM;
-        SolverCG<>            solver_CG(solver_control, GVM);
+        SolverControl solver_control(solver_its, tol_sol);
 
-        PreconditionSSOR<> preconditioner;
-        preconditioner.initialize(system_matrix, 1.2);
+        if (parameters.precision == "Mixed")
+          mixed_precision_solver.solve(
+            system_matrix, solution, rhs, solver_control);
+        else if (parameters.matrix_format == "Node-blocked")
+          {
+            Adapter::PreconditionNodeBlock<dim> preconditioner;
+            preconditioner.initialize(
+              node_block_matrix,
+              Adapter::PreconditionNodeBlock<dim>::Type::ssor,
+              1.2);
+
+            solve_iterative(
+              node_block_matrix, preconditioner, solution, rhs, solver_control);
+          }
+        else
+          {
+            PreconditionSSOR<> preconditioner;
+            preconditioner.initialize(system_matrix, 1.2);
 
-        solver_CG.solve(system_matrix, velocity, system_rhs, preconditioner);
+            solve_iterative(
+              system_matrix, preconditioner, solution, rhs, solver_control);
+          }
 
         lin_it  = solver_control.last_step();
         lin_res = solver_control.last_value();
       }
     else if (parameters.type_lin == "Direct")
-      {
-        std::cout << "\t Direct solver: " << std::endl;
-
-        SparseDirectUMFPACK A_direct;
-        A_direct.initialize(system_matrix);
-        A_direct.vmult(velocity, system_rhs);
-      }
+      direct_solver.vmult(solution, rhs);
     else
-      Assert(parameters.type_lin == "Direct" || parameters.type_lin == "CG",
+      Assert(parameters.type_lin == "Direct" || parameters.type_lin == "CG" ||
+               parameters.type_lin == "Deflated CG",
              ExcNotImplemented());
 
-    // assert divergence
-    Assert(velocity.linfty_norm() < 1e4, ExcMessage("Linear system diverged"));
-    std::cout << "\t     No of iterations:\t" << lin_it
-              << "\n \t     Final residual:\t" << lin_res << std::endl;
-    hanging_node_constraints.distribute(velocity);
+    telemetry.count("linear_iterations", lin_it);
+
+    return std::make_pair(lin_it, lin_res);
+  }
+
+
+
+  template <int dim>
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  ElastoDynamics<dim>::solve_iterative(const MatrixType &        matrix,
+                                       const PreconditionerType &preconditioner,
+                                       Vector<double> &          solution,
+                                       const Vector<double> &    rhs,
+                                       SolverControl &           solver_control)
+  {
+    const Adapter::TraceScope trace("CG");
+    // The system matrix is the same in every time step, so that the
+    // deflation space remains valid
+    if (parameters.type_lin == "Deflated CG")
+      deflated_cg.solve(matrix, solution, rhs, preconditioner, solver_control);
+    else
+      {
+        GrowingVectorMemory<> GVM;
+        SolverCG<>            solver_CG(solver_control, GVM);
+        solver_CG.solve(matrix, solution, rhs, preconditioner);
+      }
+  }
+
+
+
+  // Each column of the influence matrix is the solution for a unit load in
+  // one direction at one interface quadrature point, restricted to the
+  // interface DoFs. The load is scaled in the same way as the coupling data in
+  // assemble_rhs(). Since the system matrix is constant, the direct solver is
+  // factorized only once for all columns.
+  template <int dim>
+  void
+  ElastoDynamics<dim>::assemble_influence_matrix()
+  {
+    timer.enter_subsection("Assemble influence matrix");
+
+    const double load_factor =
+      parameters.time_integration == "Generalized-alpha" ?
+        1 - parameters.alpha_f :
+        time.get_delta_t() * parameters.theta;
+
+    Vector<double> rhs(dof_handler.n_dofs());
+    Vector<double> solution(dof_handler.n_dofs());
+
+    influence_matrix.reinit(interface_dofs.size(), interface_load.size());
+
+    QGauss<dim - 1>   face_quadrature_formula(quad_order);
+    FEFaceValues<dim> fe_face_values(*mapping,
+                                     fe,
+                                     face_quadrature_formula,
+                                     update_values | update_JxW_values);
+
+    const unsigned int                   dofs_per_cell = fe.dofs_per_cell;
+    std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+
+    unsigned int point_index = 0;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      for (const auto &face : cell->face_iterators())
+        if (face->at_boundary() == true &&
+            face->boundary_id() == interface_boundary_id)
+          {
+            fe_face_values.reinit(cell, face);
+            cell->get_dof_indices(local_dof_indices);
+
+            for (const auto f_q_point :
+                 fe_face_values.quadrature_point_indices())
+              {
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    rhs = 0.0;
+                    for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                      if (fe.system_to_component_index(i).first == d)
+                        rhs(local_dof_indices[i]) +=
+                          load_factor *
+                          fe_face_values.shape_value(i, f_q_point) *
+                          fe_face_values.JxW(f_q_point);
+
+                    // Same treatment of constraints as in assemble_rhs()
+                    hanging_node_constraints.condense(rhs);
+                    for (const auto &boundary_value : boundary_values)
+                      rhs(boundary_value.first) = 0.0;
+
+                    solution = 0.0;
+                    solve_linear_system(solution, rhs);
+                    hanging_node_constraints.distribute(solution);
+
+                    for (unsigned int k = 0; k < interface_dofs.size(); ++k)
+                      influence_matrix(k, point_index * dim + d) =
+                        solution(interface_dofs[k]);
+                  }
+                ++point_index;
+              }
+          }
+    AssertDimension(point_index * dim, interface_load.size());
+
+    std::cout << "\t Interface influence matrix: " << influence_matrix.m()
+              << " x " << influence_matrix.n() << std::endl;
+
+    timer.leave_subsection("Assemble influence matrix");
+  }
+
+
+
+  // The history response is the solution for the contributions of the
+  // previous time step without the coupling data of the new time step. It
+  // requires one solve with the full system.
+  template <int dim>
+  void
+  ElastoDynamics<dim>::compute_history_response()
+  {
+    const Adapter::TraceScope trace("Compute history response");
+    assemble_rhs(/*history_only = */ true);
+
+    timer.enter_subsection("Solve system");
+
+    // The solution vector holds a state variable in case of the theta scheme
+    // and must not be overwritten here
+    Vector<double> history_solution(dof_handler.n_dofs());
+    solve_linear_system(history_solution, system_rhs);
+    hanging_node_constraints.distribute(history_solution);
+
+    for (unsigned int k = 0; k < interface_dofs.size(); ++k)
+      interface_history(k) = history_solution(interface_dofs[k]);
+
+    interface_displacement = displacement;
+    history_timestep       = time.get_timestep();
 
     timer.leave_subsection("Solve system");
   }
 
 
 
+  // Apply the displacement update of update_displacement() on the interface
+  // DoFs only, with the solution given by the influence matrix. The state
+  // variables remain untouched.
+  template <int dim>
+  void
+  ElastoDynamics<dim>::evaluate_interface_response()
+  {
+    const Adapter::TraceScope trace("Evaluate interface response");
+    Vector<double> interface_solution(interface_history);
+    influence_matrix.vmult_add(interface_solution, interface_load);
+
+    for (unsigned int k = 0; k < interface_dofs.size(); ++k)
+      {
+        const types::global_dof_index i = interface_dofs[k];
+        if (parameters.time_integration == "Generalized-alpha")
+          interface_displacement(i) = displacement(i) + interface_solution(k);
+        else
+          interface_displacement(i) =
+            displacement(i) +
+            time.get_delta_t() * parameters.theta * interface_solution(k) +
+            time.get_delta_t() * (1 - parameters.theta) * velocity(i);
+      }
+  }
+
+
+
   template <int dim>
   void
   ElastoDynamics<dim>::update_displacement()
   {
-    // D_n+1= D_n + delta_t*theta* V_n+1 + delta_t*(1-theta)* V_n
-    displacement.add(time.get_delta_t() * parameters.theta, velocity);
-    displacement.add(time.get_delta_t() * (1 - parameters.theta), old_velocity);
+    if (parameters.time_integration == "Generalized-alpha")
+      {
+        // Newmark's kinematic relations, where old_velocity holds V_n:
+        // A_n+1 = alpha_1*dD - alpha_2*V_n - alpha_3*A_n
+        // V_n+1 = alpha_4*dD + alpha_5*V_n + alpha_6*A_n
+        // D_n+1 = D_n + dD
+        velocity.sadd(alpha_5, alpha_4, displacement_increment);
+        velocity.add(alpha_6, acceleration);
+
+        acceleration.sadd(-alpha_3, alpha_1, displacement_increment);
+        acceleration.add(-alpha_2, old_velocity);
+
+        displacement.add(1, displacement_increment);
+      }
+    else
+      {
+        // D_n+1= D_n + delta_t*theta* V_n+1 + delta_t*(1-theta)* V_n
+        displacement.add(time.get_delta_t() * parameters.theta, velocity);
+        displacement.add(time.get_delta_t() * (1 - parameters.theta),
+                         old_velocity);
+      }
+  }
+
+
+
+  template <int dim>
+  Vector<double> &
+  ElastoDynamics<dim>::solution_vector()
+  {
+    return parameters.time_integration == "Generalized-alpha" ?
+             displacement_increment :
+             velocity;
+  }
+
+
+
+  template <int dim>
+  double
+  ElastoDynamics<dim>::mass_factor() const
+  {
+    // Generalized-alpha: (1-alpha_m) * alpha_1, theta scheme: 1
+    return parameters.time_integration == "Generalized-alpha" ?
+             (1 - parameters.alpha_m) * alpha_1 :
+             1.;
+  }
+
+
+
+  template <int dim>
+  double
+  ElastoDynamics<dim>::stiffness_factor() const
+  {
+    // Generalized-alpha: 1-alpha_f, theta scheme: theta^2 * delta_t^2
+    return parameters.time_integration == "Generalized-alpha" ?
+             1 - parameters.alpha_f :
+             parameters.theta * parameters.theta * time.get_delta_t() *
+               time.get_delta_t();
+  }
+
+
+
+#ifdef DEBUG
+  template <int dim>
+  void
+  ElastoDynamics<dim>::check_rhs(const Vector<double> &forces,
+                                 const Vector<double> &d,
+                                 const Vector<double> &v) const
+  {
+    Vector<double> stiffness_part(dof_handler.n_dofs());
+    Vector<double> mass_part(dof_handler.n_dofs());
+    stiffness_matrix.vmult(stiffness_part, d);
+    mass_matrix.vmult(mass_part, v);
+
+    Vector<double> reference(forces);
+    reference.add(-1., stiffness_part, 1., mass_part);
+    hanging_node_constraints.condense(reference);
+
+    Vector<double> difference(system_rhs);
+    difference -= reference;
+    hanging_node_constraints.set_zero(difference);
+    for (const auto &boundary_value : boundary_values)
+      difference(boundary_value.first) = 0.;
+
+    const double scale = forces.linfty_norm() + stiffness_part.linfty_norm() +
+                         mass_part.linfty_norm();
+    Assert(difference.linfty_norm() <= 1e-8 * scale,
+           ExcMessage("The right-hand side does not match its formulation in "
+                      "terms of the mass matrix"));
+  }
+#endif
+
+
+
+  template <int dim>
+  unsigned int
+  ElastoDynamics<dim>::n_output_subdivisions() const
+  {
+    return parameters.output_subdivisions > 0 ? parameters.output_subdivisions :
+                                                parameters.poly_degree;
   }
 
 
@@ -679,52 +1435,185 @@ namespace Linear_Elasticity
   ElastoDynamics<dim>::output_results() const
   {
     timer.enter_subsection("Output results");
-    DataOut<dim> data_out;
-
-    // Note: There is at least paraView v 5.5 needed to visualize this output
-    DataOutBase::VtkFlags flags;
-    flags.write_higher_order_cells = true;
-    data_out.set_flags(flags);
-
-    data_out.attach_dof_handler(dof_handler);
-
-    // The postprocessor class computes straines and passes the displacement to
-    // the output
-    Postprocessor<dim> postprocessor;
-    data_out.add_data_vector(displacement, postprocessor);
-
-    // visualize the displacements on a displaced grid
-    MappingQEulerian<dim> q_mapping(parameters.poly_degree,
-                                    dof_handler,
-                                    displacement);
-    data_out.build_patches(q_mapping,
-                           parameters.poly_degree,
-                           DataOut<dim>::curved_boundary);
-
-    std::ofstream output(
-      case_path + "solution-" +
-      std::to_string(time.get_timestep() / parameters.output_interval) +
-      ".vtk");
-    data_out.write_vtk(output);
-    std::cout << "\t Output written to solution-" +
-                   std::to_string(time.get_timestep() /
-                                  parameters.output_interval) +
-                   ".vtk \n"
+
+    // The task owns a copy of the displacement, since the displacement
+    // changes in the next time step. The DoFHandler is not modified during
+    // the time loop
+    const auto snapshot = std::make_shared<const Vector<double>>(displacement);
+    const unsigned int index = time.get_timestep() / parameters.output_interval;
+    const double       current_time = time.current();
+
+    const auto write_deformed = [this, snapshot, index, current_time]() {
+      DataOut<dim> data_out;
+      data_out.attach_dof_handler(dof_handler);
+
+      // The postprocessor class computes straines and passes the displacement
+      // to the output
+      Postprocessor<dim> postprocessor;
+      data_out.add_data_vector(*snapshot, postprocessor);
+
+      // visualize the displacements on a displaced grid
+      MappingQEulerian<dim> q_mapping(parameters.poly_degree,
+                                      dof_handler,
+                                      *snapshot);
+      data_out.build_patches(q_mapping,
+                             n_output_subdivisions(),
+                             DataOut<dim>::curved_boundary);
+
+      time_series_writer.write(data_out, index, current_time);
+    };
+
+    // On the reference configuration, only the data of the cached patches is
+    // updated. Each task works on its own copy of the patches
+    const auto write_reference = [this, snapshot, index, current_time]() {
+      Adapter::CachedDataOut<dim> data_out(*reference_output);
+      data_out.build_patches(*snapshot);
+
+      time_series_writer.write(data_out, index, current_time);
+    };
+
+    if (reference_output)
+      output_writer.write(write_reference);
+    else
+      output_writer.write(write_deformed);
+
+    std::cout << "\t Writing output to "
+              << time_series_writer.get_filename(index) << " \n"
               << std::endl;
     timer.leave_subsection("Output results");
   }
 
 
 
+  template <int dim>
+  void
+  ElastoDynamics<dim>::output_monitoring() const
+  {
+    timer.enter_subsection("Output results");
+
+    if (probes)
+      probes->write(time.current(), displacement, velocity);
+
+    if (parameters.interface_output_interval > 0 &&
+        time.get_timestep() % parameters.interface_output_interval == 0)
+      {
+        // The received coupling data is converted into a nodal field, which
+        // is owned by the output task as well as the displacement
+        const auto traction = std::make_shared<Vector<double>>();
+        Adapter::project_interface_data<dim>(
+          dof_handler,
+          *mapping,
+          QGauss<dim - 1>(quad_order),
+          interface_boundary_id,
+          [this](const unsigned int point) {
+            Tensor<1, dim> value;
+            for (unsigned int d = 0; d < dim; ++d)
+              value[d] = interface_load(point * dim + d);
+            return value;
+          },
+          *traction);
+
+        const auto snapshot =
+          std::make_shared<const Vector<double>>(displacement);
+        const unsigned int index =
+          time.get_timestep() / parameters.interface_output_interval;
+        const double current_time = time.current();
+        const bool   reference    = parameters.output_geometry == "Reference" ||
+                               interface_writer.reference_geometry();
+
+        output_writer.write(
+          [this, snapshot, traction, index, current_time, reference]() {
+            Adapter::InterfaceDataOutFaces<dim> data_out(interface_boundary_id);
+            data_out.attach_dof_handler(dof_handler);
+
+            Postprocessor<dim> postprocessor;
+            data_out.add_data_vector(*snapshot, postprocessor);
+            data_out.add_data_vector(
+              *traction,
+              std::vector<std::string>(dim, "traction"),
+              DataOutFaces<dim>::type_dof_data,
+              std::vector<
+                DataComponentInterpretation::DataComponentInterpretation>(
+                dim, DataComponentInterpretation::component_is_part_of_vector));
+
+            if (reference)
+              data_out.build_patches(*mapping, n_output_subdivisions());
+            else
+              {
+                MappingQEulerian<dim> q_mapping(parameters.poly_degree,
+                                                dof_handler,
+                                                *snapshot);
+                data_out.build_patches(q_mapping, n_output_subdivisions());
+              }
+
+            interface_writer.write(data_out, index, current_time);
+          });
+      }
+
+    timer.leave_subsection("Output results");
+  }
+
+
+
+  template <int dim>
+  void
+  ElastoDynamics<dim>::write_checkpoint() const
+  {
+    timer.enter_subsection("Write checkpoint");
+
+    // The archive is a copy of the current state, which is written to disk
+    // by the task
+    auto checkpoint = std::make_shared<Adapter::CheckpointOut>();
+    checkpoint->save(triangulation);
+    checkpoint->save_dof_numbering(dof_handler);
+    checkpoint->save(time);
+    checkpoint->save_vectors(state_variables);
+
+    const std::string filename = case_path + parameters.checkpoint_file;
+    checkpoint_writer.write(
+      [checkpoint, filename]() { checkpoint->write(filename); });
+
+    std::cout << "\t Writing checkpoint to " << parameters.checkpoint_file
+              << std::endl;
+    timer.leave_subsection("Write checkpoint");
+  }
+
+
+
+  template <int dim>
+  void
+  ElastoDynamics<dim>::load_checkpoint()
+  {
+    restart->load(time);
+    restart->load_vectors(state_variables);
+    restart.reset();
+
+    std::cout << "Resuming at timestep " << time.get_timestep() << " @ "
+              << time.current() << "s" << std::endl;
+  }
+
+
+
   template <int dim>
   void
   ElastoDynamics<dim>::run()
   {
-    // In the beginning, we create the mesh and set up the data structures
+    // In the beginning, we create the mesh and set up the data structures.
+    // When resuming, the mesh and the state are read from the restart file
+    if (!parameters.trace_file.empty())
+      Adapter::Trace::enable();
+    if (parameters.resume)
+      restart = std::make_unique<Adapter::CheckpointIn>(
+        case_path + parameters.checkpoint_file);
     make_grid();
     setup_system();
-    output_results();
+    if (restart)
+      load_checkpoint();
+    else
+      output_results();
     assemble_system();
+    if (parameters.matrix_layout)
+      Adapter::print_matrix_layout(system_matrix);
 
     // Then, we initialize preCICE i.e. we pass our mesh and coupling
     // information to preCICE
@@ -734,6 +1623,14 @@ namespace Linear_Elasticity
                        std::make_shared<const QGauss<dim - 1>>(quad_order),
                        displacement);
 
+    if (parameters.interface_influence)
+      assemble_influence_matrix();
+
+    // The phases of the coupling are measured separately, for the summary as
+    // well as for the telemetry
+    adapter.attach_timer(timer);
+    telemetry.start(timer);
+
     // Then, we start the time loop. The loop itself is steered by preCICE. This
     // line replaces the usual 'while( time < end_time)'
     while (adapter.precice.isCouplingOngoing())
@@ -745,20 +1642,38 @@ namespace Linear_Elasticity
 
         // Afterwards, we start the actual time step computation
         time.increment();
+        telemetry.begin_iteration(time.get_timestep(), time.current());
 
         std::cout << std::endl
                   << "Timestep " << time.get_timestep() << " @ " << std::fixed
                   << time.current() << "s" << std::endl;
 
-        // Assemble the time dependent contribution obtained from the Fluid
-        // participant
-        assemble_rhs();
+        read_interface_load();
 
-        // ...and solver the system
-        solve();
+        if (parameters.interface_influence)
+          {
+            // Only the interface displacement is computed during the coupling
+            // iterations. The full system is solved once per time step for
+            // the history response and once more, if the time step has been
+            // accepted (see below)
+            if (history_timestep != time.get_timestep())
+              compute_history_response();
+
+            evaluate_interface_response();
+          }
+        else
+          {
+            // Assemble the time dependent contribution obtained from the
+            // Fluid participant
+            assemble_rhs();
 
-        // Update time dependent data according to the theta-scheme
-        update_displacement();
+            // ...and solver the system
+            solve();
+
+            // Update time dependent data according to the time integration
+            // scheme
+            update_displacement();
+          }
 
         // Then, we exchange data with other participants. Most of the work is
         // done in the adapter: We just need to pass both data vectors with
@@ -769,25 +1684,58 @@ namespace Linear_Elasticity
         // participant to finish their time step. Therefore, we measure the
         // timings around this functionality
         timer.enter_subsection("Advance adapter");
-        adapter.advance(displacement, dof_handler, time.get_delta_t());
+        adapter.advance(parameters.interface_influence ?
+                          interface_displacement :
+                          displacement,
+                        dof_handler,
+                        time.get_delta_t());
         timer.leave_subsection("Advance adapter");
 
+        // A time step is accepted, if preCICE does not ask for a reload
+        const bool step_accepted = !adapter.precice.isActionRequired(
+          precice::constants::actionReadIterationCheckpoint());
+
         // Next, we reload the data we have previosuly stored in the beginning
         // of the time loop. This is only relevant for implicit couplings and
         // preCICE steeres the reloading depending on the specific
         // configuration.
         adapter.reload_old_state_if_required(state_variables, time);
 
+        // With the influence matrix, the state variables are only updated for
+        // accepted time steps, using the coupling data of the last iteration
+        if (parameters.interface_influence && step_accepted)
+          {
+            assemble_rhs();
+            solve();
+            update_displacement();
+            history_timestep = numbers::invalid_unsigned_int;
+          }
+
         // At last, we ask preCICE, whether this coupling time step (= time
         // window in preCICE terms) is finished and write the result files
         if (adapter.precice.isTimeWindowComplete() &&
             time.get_timestep() % parameters.output_interval == 0)
           output_results();
+
+        if (adapter.precice.isTimeWindowComplete())
+          output_monitoring();
+
+        if (adapter.precice.isTimeWindowComplete() &&
+            parameters.checkpoint_interval > 0 &&
+            time.get_timestep() % parameters.checkpoint_interval == 0)
+          write_checkpoint();
+
+        telemetry.end_iteration(timer, adapter.precice.isTimeWindowComplete());
       }
 
     // After the time loop, we finalize the coupling i.e. terminate
-    // communication etc.
+    // communication etc. and wait for the pending output
     adapter.precice.finalize();
+    output_writer.finalize();
+    checkpoint_writer.finalize();
+
+    if (Adapter::Trace::enabled())
+      Adapter::Trace::write(case_path + parameters.trace_file);
   }
 } // namespace Linear_Elasticity
 
@@ -836,7 +1784,7 @@ main(int argc, char **argv)
       std::string case_path =
         std::string::npos == pos ? "" : parameter_file.substr(0, pos + 1);
 
-      ElastoDynamics<DIM> elastic_solver(case_path);
+      ElastoDynamics<DIM> elastic_solver(case_path, parameter_file);
       elastic_solver.run();
     }
   catch (std::exception &exc)
@@ -1,8 +1,15 @@
 #ifndef COMPRESSIBLE_NEO_HOOK_MATERIAL_H
 #define COMPRESSIBLE_NEO_HOOK_MATERIAL_H
 
+#include <deal.II/base/symmetric_tensor.h>
+#include <deal.II/base/vectorization.h>
+
 #include <deal.II/physics/elasticity/standard_tensors.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace Nonlinear_Elasticity
 {
   using namespace dealii;
@@ -10,11 +17,30 @@ namespace Nonlinear_Elasticity
    * The Material_Compressible_Neo_Hook_One_Field class is nearly the same as in
    * the original work. The density has been added as additional parameter,
    * which is needed for time dependent problems.
+   *
+   * The Kirchhoff stress and the tangent are evaluated in closed form. Since
+   * the fictitious elasticity tensor c_bar of the Neo-Hookean law vanishes
+   * identically, all terms involving it are dropped and the remaining
+   * projections onto dev_P are carried out by hand. The closed form is
+   * templated on the scalar type, so that a whole batch of quadrature points
+   * can be evaluated at once using VectorizedArray (see get_tau_Jc()).
    */
   template <int dim, typename NumberType>
   class Material_Compressible_Neo_Hook_One_Field
   {
   public:
+    /**
+     * Parts of the material law, which are evaluated. The split into
+     * isochoric and volumetric part allows to integrate both parts with
+     * different quadrature rules (selective integration).
+     */
+    enum class Contribution
+    {
+      full,
+      isochoric,
+      volumetric
+    };
+
     Material_Compressible_Neo_Hook_One_Field(const double mu,
                                              const double nu,
                                              const double rho)
@@ -35,18 +61,71 @@ namespace Nonlinear_Elasticity
       return get_Psi_vol(det_F) + get_Psi_iso(b_bar);
     }
 
-    SymmetricTensor<2, dim, NumberType>
-    get_tau(const NumberType &                         det_F,
-            const SymmetricTensor<2, dim, NumberType> &b_bar)
+    /**
+     * @brief get_tau_Jc Evaluates the Kirchhoff stress and the tangent for a
+     *        set of quadrature points, typically all points of a cell. The
+     *        points are packed into the lanes of a VectorizedArray so that
+     *        the closed-form expressions run at the SIMD width deal.II has
+     *        been configured with. Unused lanes of the last batch are filled
+     *        with a copy of the last point.
+     *
+     * @param[in]  det_F Determinant of the deformation gradient per point
+     * @param[in]  b_bar Isochoric left Cauchy-Green tensor per point
+     * @param[out] tau Kirchhoff stress per point
+     * @param[out] Jc Spatial tangent (scaled by det_F) per point
+     * @param[in]  contribution Part of the material law to be evaluated
+     */
+    void
+    get_tau_Jc(const std::vector<NumberType> &                         det_F,
+               const std::vector<SymmetricTensor<2, dim, NumberType>> &b_bar,
+               std::vector<SymmetricTensor<2, dim, NumberType>> &      tau,
+               std::vector<SymmetricTensor<4, dim, NumberType>> &      Jc,
+               const Contribution contribution = Contribution::full) const
     {
-      return get_tau_vol(det_F) + get_tau_iso(b_bar);
-    }
-
-    SymmetricTensor<4, dim, NumberType>
-    get_Jc(const NumberType &                         det_F,
-           const SymmetricTensor<2, dim, NumberType> &b_bar) const
-    {
-      return get_Jc_vol(det_F) + get_Jc_iso(b_bar);
+      using VectorizedNumber         = VectorizedArray<NumberType>;
+      constexpr unsigned int width   = VectorizedNumber::size();
+      const unsigned int     n_points = det_F.size();
+
+      Assert(b_bar.size() == n_points, ExcInternalError());
+      Assert(tau.size() == n_points, ExcInternalError());
+      Assert(Jc.size() == n_points, ExcInternalError());
+
+      VectorizedNumber                          det_F_batch;
+      SymmetricTensor<2, dim, VectorizedNumber> b_bar_batch;
+      SymmetricTensor<2, dim, VectorizedNumber> tau_batch;
+      SymmetricTensor<4, dim, VectorizedNumber> Jc_batch;
+
+      for (unsigned int q_0 = 0; q_0 < n_points; q_0 += width)
+        {
+          const unsigned int n_lanes = std::min(width, n_points - q_0);
+
+          // Pack
+          for (unsigned int v = 0; v < width; ++v)
+            {
+              const unsigned int q = q_0 + std::min(v, n_lanes - 1);
+              det_F_batch[v]       = det_F[q];
+              for (unsigned int i = 0; i < dim; ++i)
+                for (unsigned int j = i; j < dim; ++j)
+                  b_bar_batch[i][j][v] = b_bar[q][i][j];
+            }
+
+          evaluate_tau_Jc(
+            det_F_batch, b_bar_batch, tau_batch, Jc_batch, contribution);
+
+          // Unpack
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              const unsigned int q = q_0 + v;
+              for (unsigned int i = 0; i < dim; ++i)
+                for (unsigned int j = i; j < dim; ++j)
+                  {
+                    tau[q][i][j] = tau_batch[i][j][v];
+                    for (unsigned int k = 0; k < dim; ++k)
+                      for (unsigned int l = k; l < dim; ++l)
+                        Jc[q][i][j][k][l] = Jc_batch[i][j][k][l][v];
+                  }
+            }
+        }
     }
 
     NumberType
@@ -72,70 +151,63 @@ namespace Nonlinear_Elasticity
       return c_1 * (trace(b_bar) - dim);
     }
 
-    NumberType
-    get_dPsi_vol_dJ(const NumberType &det_F) const
-    {
-      return (kappa / 2.0) * (det_F - 1.0 / det_F);
-    }
-
-    SymmetricTensor<2, dim, NumberType>
-    get_tau_vol(const NumberType &det_F) const
-    {
-      return NumberType(get_dPsi_vol_dJ(det_F) * det_F) *
-             Physics::Elasticity::StandardTensors<dim>::I;
-    }
-
-    SymmetricTensor<2, dim, NumberType>
-    get_tau_iso(const SymmetricTensor<2, dim, NumberType> &b_bar) const
-    {
-      return Physics::Elasticity::StandardTensors<dim>::dev_P *
-             get_tau_bar(b_bar);
-    }
-
-    SymmetricTensor<2, dim, NumberType>
-    get_tau_bar(const SymmetricTensor<2, dim, NumberType> &b_bar) const
-    {
-      return 2.0 * c_1 * b_bar;
-    }
-
-    NumberType
-    get_d2Psi_vol_dJ2(const NumberType &det_F) const
-    {
-      return ((kappa / 2.0) * (1.0 + 1.0 / (det_F * det_F)));
-    }
-
-    SymmetricTensor<4, dim, NumberType>
-    get_Jc_vol(const NumberType &det_F) const
-    {
-      return det_F *
-             ((get_dPsi_vol_dJ(det_F) + det_F * get_d2Psi_vol_dJ2(det_F)) *
-                Physics::Elasticity::StandardTensors<dim>::IxI -
-              (2.0 * get_dPsi_vol_dJ(det_F)) *
-                Physics::Elasticity::StandardTensors<dim>::S);
-    }
-
-    SymmetricTensor<4, dim, NumberType>
-    get_Jc_iso(const SymmetricTensor<2, dim, NumberType> &b_bar) const
-    {
-      const SymmetricTensor<2, dim> tau_bar = get_tau_bar(b_bar);
-      const SymmetricTensor<2, dim> tau_iso = get_tau_iso(b_bar);
-      const SymmetricTensor<4, dim> tau_iso_x_I =
-        outer_product(tau_iso, Physics::Elasticity::StandardTensors<dim>::I);
-      const SymmetricTensor<4, dim> I_x_tau_iso =
-        outer_product(Physics::Elasticity::StandardTensors<dim>::I, tau_iso);
-      const SymmetricTensor<4, dim> c_bar = get_c_bar();
-
-      return (2.0 / dim) * trace(tau_bar) *
-               Physics::Elasticity::StandardTensors<dim>::dev_P -
-             (2.0 / dim) * (tau_iso_x_I + I_x_tau_iso) +
-             Physics::Elasticity::StandardTensors<dim>::dev_P * c_bar *
-               Physics::Elasticity::StandardTensors<dim>::dev_P;
-    }
-
-    SymmetricTensor<4, dim, double>
-    get_c_bar() const
+    // Closed form of the stress and tangent. With tau_bar = 2 c_1 b_bar and
+    // c_bar = 0, the original expressions reduce to
+    //   tau_iso = dev_P : tau_bar = tau_bar - tr(tau_bar) / dim I
+    //   tau     = tau_iso + kappa / 2 (J^2 - 1) I
+    //   Jc      = a S + b IxI - 2 / dim (tau_iso x I + I x tau_iso)
+    // with a = 2 / dim tr(tau_bar) - kappa (J^2 - 1) and
+    //      b = kappa J^2 - 2 / dim^2 tr(tau_bar).
+    // The terms containing kappa form the volumetric part, all others the
+    // isochoric part. Only the independent components (i <= j, k <= l) are
+    // written.
+    template <typename Number>
+    void
+    evaluate_tau_Jc(const Number &                         det_F,
+                    const SymmetricTensor<2, dim, Number> &b_bar,
+                    SymmetricTensor<2, dim, Number> &      tau,
+                    SymmetricTensor<4, dim, Number> &      Jc,
+                    const Contribution contribution = Contribution::full) const
     {
-      return SymmetricTensor<4, dim>();
+      const double c_iso =
+        (contribution == Contribution::volumetric) ? 0.0 : 2.0 * c_1;
+      const double kappa_vol =
+        (contribution == Contribution::isochoric) ? 0.0 : kappa;
+
+      const Number J_2        = det_F * det_F;
+      const Number tr_tau_bar = c_iso * trace(b_bar);
+      const Number p_vol      = (0.5 * kappa_vol) * (J_2 - 1.0);
+
+      const Number a = (2.0 / dim) * tr_tau_bar - kappa_vol * (J_2 - 1.0);
+      const Number b = kappa_vol * J_2 - (2.0 / (dim * dim)) * tr_tau_bar;
+
+      SymmetricTensor<2, dim, Number> tau_iso;
+      for (unsigned int i = 0; i < dim; ++i)
+        for (unsigned int j = i; j < dim; ++j)
+          tau_iso[i][j] = c_iso * b_bar[i][j];
+      for (unsigned int i = 0; i < dim; ++i)
+        tau_iso[i][i] -= (1.0 / dim) * tr_tau_bar;
+
+      tau = tau_iso;
+      for (unsigned int i = 0; i < dim; ++i)
+        tau[i][i] += p_vol;
+
+      Jc = SymmetricTensor<4, dim, Number>();
+      for (unsigned int i = 0; i < dim; ++i)
+        for (unsigned int j = i; j < dim; ++j)
+          for (unsigned int k = 0; k < dim; ++k)
+            for (unsigned int l = k; l < dim; ++l)
+              {
+                if (k == l)
+                  Jc[i][j][k][l] -= (2.0 / dim) * tau_iso[i][j];
+                if (i == j)
+                  Jc[i][j][k][l] -= (2.0 / dim) * tau_iso[k][l];
+                if (i == j && k == l)
+                  Jc[i][j][k][l] += b;
+                // S_ijkl is 1 on the diagonal and 1/2 on mixed components
+                if (i == k && j == l)
+                  Jc[i][j][k][l] += (i == j ? 1.0 : 0.5) * a;
+              }
     }
   };
 } // namespace Nonlinear_Elasticity
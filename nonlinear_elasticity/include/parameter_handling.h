@@ -3,6 +3,10 @@
 
 #include <deal.II/base/parameter_handler.h>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include "../../adapter/precice_parameter.h"
 
 namespace Nonlinear_Elasticity
@@ -79,9 +83,13 @@ namespace Nonlinear_Elasticity
      */
     struct LinearSolver
     {
-      std::string type_lin;
-      double      tol_lin;
-      double      max_iterations_lin;
+      std::string  type_lin;
+      std::string  direct_solver;
+      double       tol_lin;
+      double       max_iterations_lin;
+      unsigned int deflation_vectors;
+      std::string  matrix_format;
+      std::string  precision;
 
       static void
       declare_parameters(ParameterHandler &prm);
@@ -97,8 +105,16 @@ namespace Nonlinear_Elasticity
       {
         prm.declare_entry("Solver type",
                           "CG",
-                          Patterns::Selection("CG|Direct"),
-                          "Linear solver: CG or Direct");
+                          Patterns::Selection("CG|Deflated CG|Direct"),
+                          "Linear solver: CG, Deflated CG or Direct");
+
+        prm.declare_entry("Direct solver",
+                          "UMFPACK",
+                          Patterns::Selection("UMFPACK|MUMPS"),
+                          "Direct solver package: UMFPACK (reuses the "
+                          "symbolic factorization) or MUMPS (MPI parallel, "
+                          "factorizes from scratch, requires deal.II with "
+                          "MUMPS)");
 
         prm.declare_entry("Residual",
                           "1e-6",
@@ -110,6 +126,25 @@ namespace Nonlinear_Elasticity
           "1",
           Patterns::Double(0.0),
           "Linear solver iterations (multiples of the system matrix size)");
+
+        prm.declare_entry("Deflation vectors",
+                          "10",
+                          Patterns::Integer(0),
+                          "Number of recycled vectors of the Deflated CG");
+
+        prm.declare_entry("Matrix format",
+                          "CSR",
+                          Patterns::Selection("CSR|Node-blocked"),
+                          "Matrix format of the iterative solvers: CSR or "
+                          "Node-blocked");
+
+        prm.declare_entry("Precision",
+                          "Double",
+                          Patterns::Selection("Double|Mixed"),
+                          "Precision of the CG solver: Double or Mixed (single "
+                          "precision matrix with iterative refinement). Mixed "
+                          "stores a single precision copy of the matrix in "
+                          "addition, trading memory for bandwidth");
       }
       prm.leave_subsection();
     }
@@ -120,8 +155,23 @@ namespace Nonlinear_Elasticity
       prm.enter_subsection("Linear solver");
       {
         type_lin           = prm.get("Solver type");
+        direct_solver      = prm.get("Direct solver");
         tol_lin            = prm.get_double("Residual");
         max_iterations_lin = prm.get_double("Max iteration multiplier");
+        deflation_vectors  = prm.get_integer("Deflation vectors");
+        matrix_format      = prm.get("Matrix format");
+        precision          = prm.get("Precision");
+
+#ifndef DEAL_II_WITH_MUMPS
+        AssertThrow(direct_solver != "MUMPS",
+                    ExcMessage("The direct solver MUMPS requires deal.II to "
+                               "be configured with MUMPS"));
+#endif
+
+        AssertThrow(precision == "Double" ||
+                      (type_lin == "CG" && matrix_format == "CSR"),
+                    ExcMessage("Mixed precision requires Solver type CG and "
+                               "Matrix format CSR"));
       }
       prm.leave_subsection();
     }
@@ -134,6 +184,7 @@ namespace Nonlinear_Elasticity
       unsigned int max_iterations_NR;
       double       tol_f;
       double       tol_u;
+      std::string  assembly_scheme;
 
       static void
       declare_parameters(ParameterHandler &prm);
@@ -161,6 +212,11 @@ namespace Nonlinear_Elasticity
                           "1.0e-6",
                           Patterns::Double(0.0),
                           "Displacement error tolerance");
+
+        prm.declare_entry("Assembly scheme",
+                          "WorkStream",
+                          Patterns::Selection("WorkStream|Colored"),
+                          "Assembly scheme: WorkStream or Colored");
       }
       prm.leave_subsection();
     }
@@ -173,6 +229,7 @@ namespace Nonlinear_Elasticity
         max_iterations_NR = prm.get_integer("Max iterations Newton-Raphson");
         tol_f             = prm.get_double("Tolerance force");
         tol_u             = prm.get_double("Tolerance displacement");
+        assembly_scheme   = prm.get("Assembly scheme");
       }
       prm.leave_subsection();
     }
@@ -185,6 +242,11 @@ namespace Nonlinear_Elasticity
       double delta_t;
       double end_time;
       int    output_interval;
+      int    output_queue_depth;
+
+      std::string  output_format;
+      std::string  output_geometry;
+      unsigned int output_subdivisions;
 
       static void
       declare_parameters(ParameterHandler &prm);
@@ -209,6 +271,31 @@ namespace Nonlinear_Elasticity
                           "1",
                           Patterns::Integer(),
                           "Output interval");
+
+        prm.declare_entry("Output queue depth",
+                          "2",
+                          Patterns::Integer(0),
+                          "Number of results written in the background, 0 "
+                          "writes synchronously");
+
+        prm.declare_entry("Output format",
+                          "vtk",
+                          Patterns::Selection("vtk|vtu|hdf5"),
+                          "Output format: vtk, vtu (compressed, with a .pvd "
+                          "time series) or hdf5 (with an XDMF time series)");
+
+        prm.declare_entry("Output geometry",
+                          "Deformed",
+                          Patterns::Selection("Deformed|Reference"),
+                          "Output geometry: Deformed (rebuilt in each output "
+                          "step) or Reference (built once, warped in the "
+                          "viewer)");
+
+        prm.declare_entry("Output subdivisions",
+                          "0",
+                          Patterns::Integer(0),
+                          "Subdivisions of each cell in the output, 0 uses "
+                          "the polynomial degree");
       }
       prm.leave_subsection();
     }
@@ -218,23 +305,37 @@ namespace Nonlinear_Elasticity
     {
       prm.enter_subsection("Time");
       {
-        end_time        = prm.get_double("End time");
-        delta_t         = prm.get_double("Time step size");
-        output_interval = prm.get_integer("Output interval");
+        end_time            = prm.get_double("End time");
+        delta_t             = prm.get_double("Time step size");
+        output_interval     = prm.get_integer("Output interval");
+        output_queue_depth  = prm.get_integer("Output queue depth");
+        output_format       = prm.get("Output format");
+        output_geometry     = prm.get("Output geometry");
+        output_subdivisions = prm.get_integer("Output subdivisions");
       }
       prm.leave_subsection();
     }
 
     /**
      * @brief Discretization: Specifies parameters for time integration by an
-     *        implicit Newmark scheme and polynomial degree of the FE system
+     *        implicit Newmark or generalized-alpha scheme, polynomial degree
+     *        of the FE system and
+     *        the number of Gauss points per direction for the cell, the
+     *        volumetric part of the material law and the faces
      */
     struct Discretization
     {
+      std::string  time_integration;
+      double       spectral_radius;
+      double       alpha_m;
+      double       alpha_f;
       double       beta;
       double       gamma;
       unsigned int poly_degree;
-
+      unsigned int quad_order_cell;
+      unsigned int quad_order_vol;
+      unsigned int quad_order_face;
+      std::string  dof_renumbering;
 
       static void
       declare_parameters(ParameterHandler &prm);
@@ -248,6 +349,18 @@ namespace Nonlinear_Elasticity
     {
       prm.enter_subsection("Discretization");
       {
+        prm.declare_entry("Time integration",
+                          "Newmark",
+                          Patterns::Selection("Newmark|Generalized-alpha"),
+                          "Time integration scheme: Newmark or "
+                          "Generalized-alpha");
+
+        prm.declare_entry("Spectral radius",
+                          "0.8",
+                          Patterns::Double(0, 1),
+                          "Spectral radius at infinite frequency of the "
+                          "generalized-alpha scheme");
+
         prm.declare_entry("beta",
                           "0.25",
                           Patterns::Double(0, 0.5),
@@ -262,6 +375,32 @@ namespace Nonlinear_Elasticity
                           "3",
                           Patterns::Integer(0),
                           "Polynomial degree of the FE system");
+
+        prm.declare_entry("Quadrature order cell",
+                          "0",
+                          Patterns::Integer(0),
+                          "Gauss points per direction in the cells "
+                          "(0: polynomial degree + 2)");
+
+        prm.declare_entry("Quadrature order volumetric",
+                          "0",
+                          Patterns::Integer(0),
+                          "Gauss points per direction for the volumetric part "
+                          "of the material law (0: same as cell)");
+
+        prm.declare_entry("Quadrature order face",
+                          "0",
+                          Patterns::Integer(0),
+                          "Gauss points per direction on the coupling faces "
+                          "(0: polynomial degree + 2)");
+
+        prm.declare_entry("DoF renumbering",
+                          "Cuthill-McKee",
+                          Patterns::Selection(
+                            "None|Cuthill-McKee|Hilbert|Component-wise"),
+                          "DoF renumbering: None, Cuthill-McKee, Hilbert or "
+                          "Component-wise (Hilbert also sorts the cells of "
+                          "the assembly)");
       }
       prm.leave_subsection();
     }
@@ -271,9 +410,266 @@ namespace Nonlinear_Elasticity
     {
       prm.enter_subsection("Discretization");
       {
-        beta        = prm.get_double("beta");
-        gamma       = prm.get_double("gamma");
-        poly_degree = prm.get_integer("Polynomial degree");
+        beta            = prm.get_double("beta");
+        gamma           = prm.get_double("gamma");
+        poly_degree     = prm.get_integer("Polynomial degree");
+        dof_renumbering = prm.get("DoF renumbering");
+
+        time_integration = prm.get("Time integration");
+        spectral_radius  = prm.get_double("Spectral radius");
+
+        // Parameters of the generalized-alpha method (Chung and Hulbert). The
+        // equilibrium is evaluated at t_n+1-alpha_f for the internal and
+        // external forces and at t_n+1-alpha_m for the inertia forces. The
+        // Newmark parameters follow from the spectral radius as well.
+        if (time_integration == "Generalized-alpha")
+          {
+            alpha_m = (2. * spectral_radius - 1.) / (spectral_radius + 1.);
+            alpha_f = spectral_radius / (spectral_radius + 1.);
+            gamma   = 0.5 - alpha_m + alpha_f;
+            beta    = 0.25 * std::pow(1. - alpha_m + alpha_f, 2);
+          }
+        else
+          {
+            alpha_m = 0.;
+            alpha_f = 0.;
+          }
+
+        quad_order_cell = prm.get_integer("Quadrature order cell");
+        quad_order_vol  = prm.get_integer("Quadrature order volumetric");
+        quad_order_face = prm.get_integer("Quadrature order face");
+        if (quad_order_cell == 0)
+          quad_order_cell = poly_degree + 2;
+        if (quad_order_vol == 0)
+          quad_order_vol = quad_order_cell;
+        if (quad_order_face == 0)
+          quad_order_face = poly_degree + 2;
+      }
+      prm.leave_subsection();
+    }
+
+
+
+    /**
+     * @brief ModelOrderReduction: Specifies the POD-Galerkin reduced order
+     *        model. In the offline mode, the full order model collects
+     *        displacement snapshots and stores the reduced basis and the
+     *        empirical cubature rule at the end of the simulation. In the
+     *        online mode, the stored model is solved instead of the full
+     *        order model
+     */
+    struct ModelOrderReduction
+    {
+      std::string  rom_mode;
+      std::string  rom_file;
+      double       pod_tolerance;
+      unsigned int max_basis_size;
+      double       cubature_tolerance;
+
+      static void
+      declare_parameters(ParameterHandler &prm);
+
+      void
+      parse_parameters(ParameterHandler &prm);
+    };
+
+    void
+    ModelOrderReduction::declare_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Model order reduction");
+      {
+        prm.declare_entry("Reduced order model",
+                          "Off",
+                          Patterns::Selection("Off|Offline|Online"),
+                          "Reduced order model: Off, Offline or Online");
+
+        prm.declare_entry("Model file",
+                          "reduced_order_model.dat",
+                          Patterns::Anything(),
+                          "File of the reduced order model (relative to the "
+                          "case path)");
+
+        prm.declare_entry("POD tolerance",
+                          "1e-8",
+                          Patterns::Double(0.0, 1.0),
+                          "Admissible fraction of the discarded snapshot "
+                          "energy");
+
+        prm.declare_entry("Maximum basis size",
+                          "20",
+                          Patterns::Integer(1),
+                          "Maximum number of POD basis vectors");
+
+        prm.declare_entry("Cubature tolerance",
+                          "1e-3",
+                          Patterns::Double(0.0, 1.0),
+                          "Relative integration error of the empirical "
+                          "cubature");
+      }
+      prm.leave_subsection();
+    }
+
+    void
+    ModelOrderReduction::parse_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Model order reduction");
+      {
+        rom_mode           = prm.get("Reduced order model");
+        rom_file           = prm.get("Model file");
+        pod_tolerance      = prm.get_double("POD tolerance");
+        max_basis_size     = prm.get_integer("Maximum basis size");
+        cubature_tolerance = prm.get_double("Cubature tolerance");
+      }
+      prm.leave_subsection();
+    }
+
+
+
+    /**
+     * @brief Monitoring: Specifies the lightweight output channels next to the
+     *        volume output, i.e., the interface surface output and the point
+     *        probes
+     */
+    struct Monitoring
+    {
+      int                              interface_output_interval;
+      bool                             matrix_layout;
+      std::vector<std::vector<double>> probe_points;
+      std::string                      probe_file;
+      std::string                      telemetry_format;
+      std::string                      trace_file;
+
+      static void
+      declare_parameters(ParameterHandler &prm);
+
+      void
+      parse_parameters(ParameterHandler &prm);
+    };
+
+    void
+    Monitoring::declare_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Monitoring");
+      {
+        prm.declare_entry("Interface output interval",
+                          "0",
+                          Patterns::Integer(0),
+                          "Write the interface surface every x timesteps, 0 "
+                          "disables the interface output");
+
+        prm.declare_entry("Matrix layout report",
+                          "false",
+                          Patterns::Bool(),
+                          "Print the bandwidth and the nonzero entries of the "
+                          "matrix and time the matrix-vector product, in "
+                          "order to compare the DoF renumberings");
+
+        prm.declare_entry("Probe points",
+                          "",
+                          Patterns::Anything(),
+                          "Points, at which the displacement, velocity and "
+                          "strain are written every timestep, e.g. "
+                          "'0.6,0.2; 0.3,0.2'");
+
+        prm.declare_entry("Probe file",
+                          "probes.csv",
+                          Patterns::Anything(),
+                          "CSV file of the probes (relative to the case "
+                          "path)");
+
+        prm.declare_entry("Telemetry format",
+                          "off",
+                          Patterns::Selection("off|jsonl|csv"),
+                          "Write the timings and iteration counts of each "
+                          "coupling iteration to telemetry.jsonl or "
+                          "telemetry.csv");
+
+        prm.declare_entry("Trace file",
+                          "",
+                          Patterns::Anything(),
+                          "Record the phases of all threads and write them "
+                          "to this file in the Chrome trace format (relative "
+                          "to the case path), empty disables the tracing");
+      }
+      prm.leave_subsection();
+    }
+
+    void
+    Monitoring::parse_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Monitoring");
+      {
+        interface_output_interval =
+          prm.get_integer("Interface output interval");
+        matrix_layout    = prm.get_bool("Matrix layout report");
+        probe_file       = prm.get("Probe file");
+        telemetry_format = prm.get("Telemetry format");
+        trace_file       = prm.get("Trace file");
+
+        probe_points.clear();
+        for (const auto &point :
+             Utilities::split_string_list(prm.get("Probe points"), ';'))
+          {
+            probe_points.emplace_back();
+            for (const auto &coordinate : Utilities::split_string_list(point))
+              probe_points.back().push_back(
+                Utilities::string_to_double(coordinate));
+          }
+      }
+      prm.leave_subsection();
+    }
+
+
+
+    /**
+     * @brief Checkpointing: Specifies the restart files, from which an
+     *        interrupted simulation can be resumed
+     */
+    struct Checkpointing
+    {
+      int         checkpoint_interval;
+      std::string checkpoint_file;
+      bool        resume;
+
+      static void
+      declare_parameters(ParameterHandler &prm);
+
+      void
+      parse_parameters(ParameterHandler &prm);
+    };
+
+    void
+    Checkpointing::declare_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Checkpointing");
+      {
+        prm.declare_entry("Checkpoint interval",
+                          "0",
+                          Patterns::Integer(0),
+                          "Write the restart file every x timesteps, 0 "
+                          "disables the checkpointing");
+
+        prm.declare_entry("Checkpoint file",
+                          "restart.bin",
+                          Patterns::Anything(),
+                          "Restart file (relative to the case path)");
+
+        prm.declare_entry("Resume",
+                          "false",
+                          Patterns::Bool(),
+                          "Resume the simulation from the restart file");
+      }
+      prm.leave_subsection();
+    }
+
+    void
+    Checkpointing::parse_parameters(ParameterHandler &prm)
+    {
+      prm.enter_subsection("Checkpointing");
+      {
+        checkpoint_interval = prm.get_integer("Checkpoint interval");
+        checkpoint_file     = prm.get("Checkpoint file");
+        resume              = prm.get_bool("Resume");
       }
       prm.leave_subsection();
     }
@@ -285,6 +681,9 @@ namespace Nonlinear_Elasticity
                            public NonlinearSolver,
                            public Time,
                            public Discretization,
+                           public ModelOrderReduction,
+                           public Monitoring,
+                           public Checkpointing,
                            public PreciceAdapterConfiguration
 
     {
@@ -316,7 +715,10 @@ namespace Nonlinear_Elasticity
       LinearSolver::declare_parameters(prm);
       NonlinearSolver::declare_parameters(prm);
       Time::declare_parameters(prm);
+      Monitoring::declare_parameters(prm);
+      Checkpointing::declare_parameters(prm);
       Discretization::declare_parameters(prm);
+      ModelOrderReduction::declare_parameters(prm);
       PreciceAdapterConfiguration::declare_parameters(prm);
     }
 
@@ -327,7 +729,10 @@ namespace Nonlinear_Elasticity
       LinearSolver::parse_parameters(prm);
       NonlinearSolver::parse_parameters(prm);
       Time::parse_parameters(prm);
+      Monitoring::parse_parameters(prm);
+      Checkpointing::parse_parameters(prm);
       Discretization::parse_parameters(prm);
+      ModelOrderReduction::parse_parameters(prm);
       PreciceAdapterConfiguration::parse_parameters(prm);
     }
   } // namespace Parameters
@@ -0,0 +1,491 @@
+#ifndef REDUCED_ORDER_MODEL_H
+#define REDUCED_ORDER_MODEL_H
+
+#include <deal.II/base/exceptions.h>
+
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Nonlinear_Elasticity
+{
+  using namespace dealii;
+
+  /**
+   * The ReducedOrderModel class holds the data of a POD-Galerkin reduced order
+   * model with hyper-reduction:
+   *
+   * - A basis of the displacement field, which is computed from snapshots of
+   *   full order runs by a proper orthogonal decomposition (POD). Since the
+   *   number of snapshots is much smaller than the number of DoFs, the method
+   *   of snapshots is used, i.e., the eigenvalue problem is solved for the
+   *   small correlation matrix of the snapshots.
+   *
+   * - An empirical cubature rule, i.e., a small subset of cells with positive
+   *   weights, such that the weighted sum of the reduced internal forces of
+   *   these cells reproduces the sum over all cells for the training data.
+   *   The cells are selected greedily (Hernandez et al., 2017). The
+   *   training data is added snapshot by snapshot and compressed right away,
+   *   so that only its numerical rank is stored per cell instead of the
+   *   projected forces of all snapshots.
+   *
+   * The class only implements the algebra. Evaluating the cell contributions
+   * is left to the Solid class, which uses the regular assembler.
+   */
+  class ReducedOrderModel
+  {
+  public:
+    /**
+     * @brief compute_basis Computes the POD basis of a set of snapshots. The
+     *        basis is orthonormal in the Euclidean inner product.
+     *
+     * @param[in]  snapshots Displacement vectors of the full order model
+     * @param[in]  tolerance Admissible fraction of the discarded snapshot
+     *             energy, i.e., of the sum of the discarded eigenvalues
+     * @param[in]  max_size Maximum number of basis vectors
+     */
+    void
+    compute_basis(const std::vector<Vector<double>> &snapshots,
+                  const double                       tolerance,
+                  const unsigned int                 max_size);
+
+    /**
+     * @brief add_training_data Adds the internal forces of one snapshot to
+     *        the training data of the empirical cubature. The rows of all
+     *        snapshots are compressed to an orthonormal basis of their span,
+     *        which leaves the inner products and norms used by the cubature
+     *        unchanged. Directions below 1e-7 of the largest singular value
+     *        are dropped.
+     *
+     * @param[in]  cell_contributions One vector per active cell, which holds
+     *             the internal forces of this cell projected onto the basis
+     */
+    void
+    add_training_data(const std::vector<Vector<double>> &cell_contributions);
+
+    /**
+     * @brief compute_cubature Selects the cells and weights of the empirical
+     *        cubature rule from the training data added so far and releases
+     *        the training data afterwards.
+     *
+     * @param[in]  tolerance Relative tolerance for the integration error of
+     *             the summed contributions
+     */
+    void
+    compute_cubature(const double tolerance);
+
+    /**
+     * @brief write Stores the basis and the cubature rule in @p filename
+     */
+    void
+    write(const std::string &filename) const;
+
+    /**
+     * @brief read Loads the basis and the cubature rule from @p filename and
+     *        checks, whether they match the discretization
+     *
+     * @param[in]  filename Name of the model file
+     * @param[in]  n_dofs Number of DoFs of the discretization
+     * @param[in]  n_active_cells Number of active cells of the triangulation
+     */
+    void
+    read(const std::string &filename,
+         const unsigned int n_dofs,
+         const unsigned int n_active_cells);
+
+    /**
+     * @brief set_full_order_step_time Stores the wall time per time step of
+     *        the full order model, which the reduced model is compared to
+     */
+    void
+    set_full_order_step_time(const double step_time)
+    {
+      full_order_step_time = step_time;
+    }
+
+    /**
+     * @brief get_full_order_step_time Returns the wall time per time step of
+     *        the full order model or zero, if it is unknown
+     */
+    double
+    get_full_order_step_time() const
+    {
+      return full_order_step_time;
+    }
+
+    /**
+     * @brief size Returns the number of basis vectors
+     */
+    unsigned int
+    size() const
+    {
+      return basis.size();
+    }
+
+    /**
+     * @brief basis_vector Returns the basis vector @p k
+     */
+    const Vector<double> &
+    basis_vector(const unsigned int k) const
+    {
+      AssertIndexRange(k, basis.size());
+      return basis[k];
+    }
+
+    /**
+     * @brief basis_vector Returns the basis vector @p k for modification,
+     *        e.g., to apply homogeneous constraints
+     */
+    Vector<double> &
+    basis_vector(const unsigned int k)
+    {
+      AssertIndexRange(k, basis.size());
+      return basis[k];
+    }
+
+    /**
+     * @brief get_cells Returns the active cell indices of the cubature cells
+     */
+    const std::vector<unsigned int> &
+    get_cells() const
+    {
+      return cells;
+    }
+
+    /**
+     * @brief get_weights Returns the cubature weights of the cells in
+     *        @p get_cells()
+     */
+    const std::vector<double> &
+    get_weights() const
+    {
+      return weights;
+    }
+
+  private:
+    std::vector<Vector<double>> basis;
+    std::vector<unsigned int>   cells;
+    std::vector<double>         weights;
+    double                      full_order_step_time = 0;
+
+    // Compressed training data of the cubature, one vector per active cell
+    std::vector<Vector<double>> training_data;
+
+    // Computes the least squares weights of the columns in cells for the
+    // given target
+    void
+    compute_weights(const Vector<double> &target);
+  };
+
+
+
+  inline void
+  ReducedOrderModel::compute_basis(const std::vector<Vector<double>> &snapshots,
+                                   const double       tolerance,
+                                   const unsigned int max_size)
+  {
+    const unsigned int n_snapshots = snapshots.size();
+    AssertThrow(n_snapshots > 0,
+                ExcMessage("No snapshots available to compute a POD basis"));
+
+    // Correlation matrix of the snapshots
+    LAPACKFullMatrix<double> correlation(n_snapshots, n_snapshots);
+    for (unsigned int i = 0; i < n_snapshots; ++i)
+      for (unsigned int j = 0; j <= i; ++j)
+        {
+          const double value = snapshots[i] * snapshots[j];
+          correlation(i, j)  = value;
+          correlation(j, i)  = value;
+        }
+
+    // The correlation matrix is symmetric positive semi-definite, so that the
+    // singular values are the eigenvalues and the left singular vectors the
+    // eigenvectors, both sorted in descending order
+    correlation.compute_svd();
+
+    double total_energy = 0;
+    for (unsigned int i = 0; i < n_snapshots; ++i)
+      total_energy += correlation.singular_value(i);
+    AssertThrow(total_energy > 0,
+                ExcMessage("All snapshots are zero, a POD basis cannot be "
+                           "computed"));
+
+    // Keep the dominant modes until the discarded energy drops below the
+    // tolerance
+    unsigned int n_modes = 0;
+    double       energy  = 0;
+    while (n_modes < std::min(max_size, n_snapshots) &&
+           energy < (1. - tolerance) * total_energy &&
+           correlation.singular_value(n_modes) >
+             1e-12 * correlation.singular_value(0))
+      energy += correlation.singular_value(n_modes++);
+
+    // Modes of the full order space: phi_k = 1/sqrt(lambda_k) sum_j U_jk s_j
+    const LAPACKFullMatrix<double> &U = correlation.get_svd_u();
+
+    basis.resize(n_modes);
+    for (unsigned int k = 0; k < n_modes; ++k)
+      {
+        basis[k].reinit(snapshots[0].size());
+        for (unsigned int j = 0; j < n_snapshots; ++j)
+          basis[k].add(U(j, k), snapshots[j]);
+        basis[k] /= std::sqrt(correlation.singular_value(k));
+      }
+
+    std::cout << "POD basis: " << n_modes << " of " << n_snapshots
+              << " modes, relative energy " << energy / total_energy
+              << std::endl;
+  }
+
+
+
+  inline void
+  ReducedOrderModel::add_training_data(
+    const std::vector<Vector<double>> &cell_contributions)
+  {
+    const unsigned int n_cells = cell_contributions.size();
+    AssertThrow(n_cells > 0, ExcMessage("No cell contributions available"));
+    if (training_data.empty())
+      training_data.resize(n_cells);
+    AssertThrow(training_data.size() == n_cells,
+                ExcMessage("The number of cells of the training data changed"));
+
+    // Stack the stored rows and the new ones, i.e., M = [R; B], and compute
+    // the eigenvectors U of the small matrix M*M^T. The rows U^T*M span the
+    // same space as the rows of M and are orthogonal, so that they replace M
+    // without changing M^T*M.
+    const unsigned int n_old  = training_data[0].size();
+    const unsigned int n_new  = cell_contributions[0].size();
+    const unsigned int n_rows = n_old + n_new;
+
+    const auto entry = [&](const unsigned int e, const unsigned int r) {
+      return r < n_old ? training_data[e](r) :
+                         cell_contributions[e](r - n_old);
+    };
+
+    LAPACKFullMatrix<double> gram(n_rows, n_rows);
+    for (unsigned int e = 0; e < n_cells; ++e)
+      for (unsigned int i = 0; i < n_rows; ++i)
+        for (unsigned int j = 0; j <= i; ++j)
+          gram(i, j) += entry(e, i) * entry(e, j);
+    for (unsigned int i = 0; i < n_rows; ++i)
+      for (unsigned int j = 0; j < i; ++j)
+        gram(j, i) = gram(i, j);
+
+    // The singular values of the symmetric positive semi-definite Gram
+    // matrix are the squared singular values of M
+    gram.compute_svd();
+    unsigned int rank = 0;
+    while (rank < n_rows &&
+           gram.singular_value(rank) > 1e-14 * gram.singular_value(0))
+      ++rank;
+
+    const LAPACKFullMatrix<double> &U = gram.get_svd_u();
+    Vector<double>                  column(rank);
+    for (unsigned int e = 0; e < n_cells; ++e)
+      {
+        column = 0;
+        for (unsigned int k = 0; k < rank; ++k)
+          for (unsigned int r = 0; r < n_rows; ++r)
+            column(k) += U(r, k) * entry(e, r);
+        training_data[e] = column;
+      }
+  }
+
+
+
+  inline void
+  ReducedOrderModel::compute_cubature(const double tolerance)
+  {
+    const unsigned int n_cells = training_data.size();
+    AssertThrow(n_cells > 0, ExcMessage("No cell contributions available"));
+
+    // The target is the integral over all cells, i.e., all weights are one
+    Vector<double> target(training_data[0].size());
+    for (const auto &contribution : training_data)
+      target += contribution;
+
+    const double target_norm = target.l2_norm();
+    AssertThrow(target_norm > 0,
+                ExcMessage("The internal forces of all snapshots vanish, an "
+                           "empirical cubature cannot be computed"));
+
+    std::vector<double> norms(n_cells);
+    for (unsigned int e = 0; e < n_cells; ++e)
+      norms[e] = training_data[e].l2_norm();
+
+    cells.clear();
+    weights.clear();
+
+    Vector<double> residual(target);
+    for (unsigned int iteration = 0;
+         iteration < n_cells && residual.l2_norm() > tolerance * target_norm;
+         ++iteration)
+      {
+        // Select the cell, whose contribution points most in the direction of
+        // the remaining integration error
+        unsigned int best_cell  = numbers::invalid_unsigned_int;
+        double       best_value = 0;
+        for (unsigned int e = 0; e < n_cells; ++e)
+          if (norms[e] > 0 &&
+              std::find(cells.begin(), cells.end(), e) == cells.end())
+            {
+              const double value = (training_data[e] * residual) / norms[e];
+              if (value > best_value)
+                {
+                  best_value = value;
+                  best_cell  = e;
+                }
+            }
+
+        if (best_cell == numbers::invalid_unsigned_int)
+          break;
+
+        cells.push_back(best_cell);
+        compute_weights(target);
+
+        residual = target;
+        for (unsigned int i = 0; i < cells.size(); ++i)
+          residual.add(-weights[i], training_data[cells[i]]);
+      }
+
+    std::cout << "Empirical cubature: " << cells.size() << " of " << n_cells
+              << " cells, relative error " << residual.l2_norm() / target_norm
+              << ", rank of the training data " << target.size()
+              << std::endl;
+
+    std::vector<Vector<double>>().swap(training_data);
+  }
+
+
+
+  inline void
+  ReducedOrderModel::compute_weights(const Vector<double> &target)
+  {
+    // Least squares fit by means of the pseudo inverse. Cells with a
+    // non-positive weight are removed and the fit is repeated, so that the
+    // resulting rule has positive weights only.
+    while (!cells.empty())
+      {
+        const unsigned int       n_rows = target.size();
+        LAPACKFullMatrix<double> A(n_rows, cells.size());
+        for (unsigned int i = 0; i < cells.size(); ++i)
+          for (unsigned int r = 0; r < n_rows; ++r)
+            A(r, i) = training_data[cells[i]](r);
+
+        A.compute_inverse_svd(1e-12);
+
+        Vector<double> w(cells.size());
+        A.vmult(w, target);
+
+        std::vector<unsigned int> positive_cells;
+        weights.clear();
+        for (unsigned int i = 0; i < cells.size(); ++i)
+          if (w(i) > 0)
+            {
+              positive_cells.push_back(cells[i]);
+              weights.push_back(w(i));
+            }
+
+        if (positive_cells.size() == cells.size())
+          return;
+
+        cells.swap(positive_cells);
+      }
+
+    weights.clear();
+  }
+
+
+
+  inline void
+  ReducedOrderModel::write(const std::string &filename) const
+  {
+    std::ofstream out(filename, std::ios::binary);
+    AssertThrow(out, ExcIO());
+
+    // A text header with the sizes and the wall time per time step of the
+    // full order model, the cubature rule, and the basis vectors in binary
+    // format
+    const unsigned int n_dofs = basis.empty() ? 0 : basis[0].size();
+    out << std::setprecision(16);
+    out << n_dofs << " " << basis.size() << " " << cells.size() << " "
+        << full_order_step_time << "\n";
+    for (unsigned int i = 0; i < cells.size(); ++i)
+      out << cells[i] << " " << weights[i] << "\n";
+
+    for (const auto &vector : basis)
+      vector.block_write(out);
+
+    AssertThrow(out, ExcIO());
+  }
+
+
+
+  inline void
+  ReducedOrderModel::read(const std::string &filename,
+                          const unsigned int n_dofs,
+                          const unsigned int n_active_cells)
+  {
+    std::ifstream in(filename, std::ios::binary);
+    AssertThrow(in, ExcMessage("Could not open the reduced order model " +
+                               filename));
+
+    // A model of a different discretization would lead to out of bounds
+    // accesses in the solver, so that all sizes and cell indices are checked
+    const std::string error_message =
+      "The reduced order model " + filename +
+      " does not match the discretization";
+
+    std::string line;
+    std::getline(in, line);
+
+    std::istringstream header(line);
+    unsigned int       file_n_dofs = 0, n_modes = 0, n_cells = 0;
+    AssertThrow(header >> file_n_dofs >> n_modes >> n_cells,
+                ExcMessage("Invalid header of the reduced order model " +
+                           filename));
+    // Models written without the wall time of the full order model remain
+    // valid
+    if (!(header >> full_order_step_time))
+      full_order_step_time = 0;
+    AssertThrow(file_n_dofs == n_dofs && n_modes > 0 &&
+                  n_cells <= n_active_cells,
+                ExcMessage(error_message));
+
+    cells.resize(n_cells);
+    weights.resize(n_cells);
+    for (unsigned int i = 0; i < n_cells; ++i)
+      {
+        std::getline(in, line);
+        AssertThrow(std::istringstream(line) >> cells[i] >> weights[i],
+                    ExcMessage("Invalid cubature rule in the reduced order "
+                               "model " +
+                               filename));
+        AssertThrow(cells[i] < n_active_cells, ExcMessage(error_message));
+        AssertThrow(std::isfinite(weights[i]) && weights[i] >= 0,
+                    ExcMessage("Invalid cubature weight in the reduced order "
+                               "model " +
+                               filename));
+      }
+
+    basis.resize(n_modes);
+    for (auto &vector : basis)
+      {
+        vector.block_read(in);
+        AssertThrow(vector.size() == n_dofs, ExcMessage(error_message));
+      }
+
+    AssertThrow(in, ExcIO());
+  }
+} // namespace Nonlinear_Elasticity
+
+#endif // REDUCED_ORDER_MODEL_H
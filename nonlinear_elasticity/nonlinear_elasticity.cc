@@ -1,4 +1,5 @@
 #include <deal.II/base/function.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/quadrature_point_data.h>
@@ -15,6 +16,7 @@
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_system.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q1.h>
 #include <deal.II/fe/mapping_q_eulerian.h>
 
 #include <deal.II/grid/grid_generator.h>
@@ -29,6 +31,7 @@
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/lapack_full_matrix.h>
 #include <deal.II/lac/precondition.h>
 #include <deal.II/lac/precondition_selector.h>
 #include <deal.II/lac/solver_cg.h>
@@ -49,11 +52,26 @@
 #include <iostream>
 
 #include "../adapter/adapter.h"
+#include "../adapter/cached_data_out.h"
+#include "../adapter/checkpoint.h"
+#include "../adapter/colored_assembly.h"
+#include "../adapter/deflated_cg.h"
+#include "../adapter/dof_renumbering.h"
+#include "../adapter/interface_output.h"
+#include "../adapter/mixed_precision_solver.h"
+#include "../adapter/node_block_sparse_matrix.h"
+#include "../adapter/output_writer.h"
+#include "../adapter/point_probes.h"
 #include "../adapter/q_equidistant.h"
+#include "../adapter/sparse_direct_solver.h"
+#include "../adapter/telemetry.h"
 #include "../adapter/time.h"
+#include "../adapter/time_series_writer.h"
+#include "../adapter/trace.h"
 #include "include/compressible_neo_hook_material.h"
 #include "include/parameter_handling.h"
 #include "include/postprocessor.h"
+#include "include/reduced_order_model.h"
 
 namespace Nonlinear_Elasticity
 {
@@ -88,19 +106,19 @@ namespace Nonlinear_Elasticity
     {
       return material->get_Psi(det_F, b_bar);
     }
-    // Kirchhoff stress
-    SymmetricTensor<2, dim, NumberType>
-    get_tau(const NumberType &                         det_F,
-            const SymmetricTensor<2, dim, NumberType> &b_bar) const
-    {
-      return material->get_tau(det_F, b_bar);
-    }
-    // Tangent
-    SymmetricTensor<4, dim, NumberType>
-    get_Jc(const NumberType &                         det_F,
-           const SymmetricTensor<2, dim, NumberType> &b_bar) const
+    // Kirchhoff stress and tangent for a batch of quadrature points
+    void
+    get_tau_Jc(
+      const std::vector<NumberType> &                         det_F,
+      const std::vector<SymmetricTensor<2, dim, NumberType>> &b_bar,
+      std::vector<SymmetricTensor<2, dim, NumberType>> &      tau,
+      std::vector<SymmetricTensor<4, dim, NumberType>> &      Jc,
+      const typename Material_Compressible_Neo_Hook_One_Field<dim, NumberType>::
+        Contribution contribution =
+          Material_Compressible_Neo_Hook_One_Field<dim, NumberType>::
+            Contribution::full) const
     {
-      return material->get_Jc(det_F, b_bar);
+      material->get_tau_Jc(det_F, b_bar, tau, Jc, contribution);
     }
     // Density
     NumberType
@@ -130,7 +148,7 @@ namespace Nonlinear_Elasticity
   class Solid
   {
   public:
-    Solid(const std::string &case_path);
+    Solid(const std::string &case_path, const std::string &parameter_file);
 
     virtual ~Solid();
 
@@ -154,6 +172,12 @@ namespace Nonlinear_Elasticity
     assemble_system(const BlockVector<double> &solution_delta,
                     const BlockVector<double> &acceleration);
 
+    // Assemble the time invariant mass matrix and body force vector. Both are
+    // stored globally, so that the inertia contribution reduces to a single
+    // matrix-vector product per residual evaluation
+    void
+    assemble_mass_matrix();
+
     // We use a separate data structure to perform the assembly. It needs access
     // to some low-level data, so we simply befriend the class instead of
     // creating a complex interface to provide access as necessary.
@@ -162,7 +186,7 @@ namespace Nonlinear_Elasticity
 
     // Apply Dirichlet boundary conditions on the displacement field
     void
-    make_constraints(const int &it_nr);
+    make_constraints();
 
     // Create and update the quadrature points. Here, no data needs to be copied
     // into a global object, so the copy_local_to_global function is empty:
@@ -176,25 +200,77 @@ namespace Nonlinear_Elasticity
     std::pair<unsigned int, double>
     solve_linear_system(BlockVector<double> &newton_update);
 
-    // Solution retrieval
-    BlockVector<double>
-    get_total_solution(const BlockVector<double> &solution_delta) const;
+    // Run the (deflated) CG solver for the given matrix format
+    template <typename MatrixType, typename PreconditionerType>
+    void
+    solve_iterative(const MatrixType &        matrix,
+                    const PreconditionerType &preconditioner,
+                    BlockVector<double> &     newton_update,
+                    SolverControl &           solver_control);
 
-    // Update fnuctions for time dependent variables according to Newmarks
+    // Update functions for time dependent variables according to Newmarks
     // scheme
     void
-    update_acceleration(BlockVector<double> &displacement_delta);
+    update_acceleration(const BlockVector<double> &displacement_delta);
 
     void
-    update_velocity(BlockVector<double> &displacement_delta);
+    update_state_variables(const BlockVector<double> &displacement_delta);
+
+    // Functions of the reduced order model. In the offline mode, the POD basis
+    // and the empirical cubature rule are computed from the collected
+    // snapshots at the end of the simulation. The wall time per time step of
+    // the full order model is stored along with the model
+    void
+    compute_reduced_order_model(const double step_time);
+
+    // In the online mode, the stored model is read and projected once. The
+    // Newton scheme then operates on the reduced coordinates, i.e., the
+    // vectors passed to the following functions have the size of the basis
+    void
+    setup_reduced_system();
+
+    void
+    assemble_reduced_system(const BlockVector<double> &reduced_delta);
+
+    std::pair<unsigned int, double>
+    solve_reduced_system(BlockVector<double> &reduced_update);
 
     void
-    update_old_variables();
+    update_reduced_acceleration(const BlockVector<double> &reduced_delta);
+
+    void
+    update_reduced_state_variables(const BlockVector<double> &reduced_delta);
+
+    // Evaluates the displacement field of the reduced coordinates at the
+    // given DoFs
+    void
+    reconstruct(const BlockVector<double> &                 reduced,
+                BlockVector<double> &                       full,
+                const std::vector<types::global_dof_index> &dofs) const;
 
     // Post-processing and writing data to file :
     void
     output_results() const;
 
+    // Write the restart file in the background
+    void
+    write_checkpoint() const;
+
+    // Read the time and the state variables from the restart file. The
+    // triangulation and the DoF numbering are read in make_grid() and
+    // system_setup()
+    void
+    load_checkpoint();
+
+    // Subdivisions of each cell in the output
+    unsigned int
+    n_output_subdivisions() const;
+
+    // Write the probes and, if requested, the interface surface including the
+    // coupling data
+    void
+    output_monitoring() const;
+
     const Parameters::AllParameters parameters;
 
     double vol_reference;
@@ -226,10 +302,32 @@ namespace Nonlinear_Elasticity
 
     std::vector<types::global_dof_index> dofs_per_block;
 
+    // Vector component of each local shape function. It is needed in the
+    // innermost assembly loops, so it is tabulated once instead of querying
+    // the FESystem every time
+    std::vector<unsigned int> component_of_dof;
+
+    // Active cells in the order of the assembly, i.e., along the Hilbert
+    // curve for the Hilbert DoF renumbering and in the order of the
+    // triangulation otherwise
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> assembly_cells;
+
+    // Active cells grouped into colors without shared DoFs, used for the
+    // colored assembly scheme. Each color is sorted like assembly_cells
+    std::vector<std::vector<typename DoFHandler<dim>::active_cell_iterator>>
+      colored_cells;
+
     const QGauss<dim>     qf_cell;
+    const QGauss<dim>     qf_vol;
     const QGauss<dim - 1> qf_face;
     const unsigned int    n_q_points;
     const unsigned int    n_q_points_f;
+
+    // Integrate the volumetric part of the material law with the reduced
+    // quadrature qf_vol
+    const bool selective_integration;
+    // Solve the reduced order model instead of the full order model
+    const bool reduced_model_online;
     // Interface ID, which is later assigned to the mesh region for coupling
     // It is chosen arbotrarily
     const unsigned int boundary_interface_id;
@@ -246,6 +344,15 @@ namespace Nonlinear_Elasticity
     const double alpha_6 =
       (1 - (parameters.gamma / (2 * parameters.beta))) * parameters.delta_t;
 
+    // Generalized-alpha parameters: The internal forces are evaluated at
+    // t_n+1-alpha_f and the inertia forces at t_n+1-alpha_m. Both are zero
+    // for the plain Newmark scheme.
+    const double alpha_m = parameters.alpha_m;
+    const double alpha_f = parameters.alpha_f;
+
+    // Minimum number of vector entries per task in the Newmark updates
+    static constexpr unsigned int newmark_grain_size = 4096;
+
     // Read body force from parameter file
     const Tensor<1, 3, double> body_force = parameters.body_force;
 
@@ -259,22 +366,99 @@ namespace Nonlinear_Elasticity
     AffineConstraints<double> constraints;
     BlockSparsityPattern      sparsity_pattern;
     BlockSparseMatrix<double> tangent_matrix;
+    BlockSparseMatrix<double> mass_matrix;
     BlockVector<double>       system_rhs;
+    BlockVector<double>       body_force_vector;
+    BlockVector<double>       inertia_force;
     BlockVector<double>       total_displacement;
-    BlockVector<double>       total_displacement_old;
     BlockVector<double>       velocity;
     BlockVector<double>       velocity_old;
     BlockVector<double>       acceleration;
     BlockVector<double>       acceleration_old;
 
+    // Persistent Newton workspace, sized once in system_setup, so that the
+    // time loop does not allocate any global vectors
+    BlockVector<double> newton_update;
+
+    // Global indices of all DoFs, which are not subject to a constraint. They
+    // are used to compute the residual and update norms
+    std::vector<types::global_dof_index> unconstrained_dofs;
+
+    // The direct solver keeps its symbolic factorization, since the sparsity
+    // pattern of the tangent matrix is fixed after system_setup
+    Adapter::SparseDirectSolver direct_solver;
+
+    // The deflated CG recycles the Newton updates of previous solves. The
+    // initial guess is not extrapolated, since consecutive Newton updates are
+    // no predictors of each other
+    Adapter::DeflatedCG deflated_cg;
+
+    // Copy of the tangent matrix in node blocked format for the iterative
+    // solvers
+    Adapter::NodeBlockSparseMatrix<dim> node_block_matrix;
+
+    // Single precision copy of the tangent matrix for the mixed precision CG
+    Adapter::MixedPrecisionSolver mixed_precision_solver;
+
+    // Reduced order model. In the offline mode, the displacement is stored at
+    // the end of each time window. In the online mode, the state is described
+    // by the reduced coordinates and the internal forces are only integrated
+    // on the reduced cells, i.e., the cells of the empirical cubature and the
+    // interface cells, which carry the coupling data
+    ReducedOrderModel           rom;
+    std::vector<Vector<double>> snapshots;
+
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> reduced_cells;
+    std::vector<double> reduced_cell_weights;
+    // DoFs of all reduced cells, on which the displacement is reconstructed
+    // in each Newton iteration
+    std::vector<types::global_dof_index> reduced_dofs;
+    // DoFs of the interface cells and the probes, on which the displacement
+    // is reconstructed after each time step. The full field is only
+    // reconstructed for the volume output
+    std::vector<types::global_dof_index> monitored_dofs;
+
+    FullMatrix<double>  reduced_mass_matrix;
+    FullMatrix<double>  reduced_tangent;
+    Vector<double>      reduced_body_force;
+    Vector<double>      reduced_rhs;
+    BlockVector<double> reduced_displacement;
+    BlockVector<double> reduced_velocity;
+    BlockVector<double> reduced_velocity_old;
+    BlockVector<double> reduced_acceleration;
+    BlockVector<double> reduced_acceleration_old;
+    BlockVector<double> reconstructed_delta;
+
     // Alias to collect all time dependent variables in a single vector
     // This is directly passed to the Adapter routine in order to
-    // store these variables for implicit couplings.
+    // store these variables for implicit couplings. The state at the
+    // beginning of a time step is fully described by the displacement and the
+    // old velocity and acceleration, since the remaining vectors are
+    // recomputed from these.
     std::vector<BlockVector<double> *> state_variables;
 
+    // Writes the result files in the selected format (in the background)
+    mutable Adapter::TimeSeriesWriter<dim> time_series_writer;
+    mutable Adapter::OutputWriter          output_writer;
+
+    // Output patches on the reference configuration, which are built once
+    std::unique_ptr<Adapter::CachedDataOut<dim>> reference_output;
+
+    // Lightweight output channels for monitoring
+    mutable Adapter::TimeSeriesWriter<dim - 1, dim> interface_writer;
+    std::unique_ptr<Adapter::PointProbes<dim>>      probes;
+
+    // The restart file is read during the setup, if the simulation is
+    // resumed, and written in the background
+    std::unique_ptr<Adapter::CheckpointIn> restart;
+    mutable Adapter::OutputWriter          checkpoint_writer;
+
     // In order to measure some timings
     mutable TimerOutput timer;
 
+    // Timings and iteration counts of each coupling iteration
+    Adapter::Telemetry telemetry;
+
     // The main adapter objects: The time class keeps track of the current time
     // and time steps. The Adapter class includes all functionalities for
     // coupling via preCICE. Look at the documentation of the class for more
@@ -311,11 +495,15 @@ namespace Nonlinear_Elasticity
 
     // Methods to calculate erros
     void
-    get_error_residual(Errors &error_residual);
+    get_error_residual(Errors &error_residual) const;
 
     void
     get_error_update(const BlockVector<double> &newton_update,
-                     Errors &                   error_update);
+                     Errors &                   error_update) const;
+
+    // l2 norm of a vector restricted to the unconstrained DoFs
+    double
+    unconstrained_l2_norm(const BlockVector<double> &vector) const;
 
     // Print information to screen during simulation
     static void
@@ -328,9 +516,9 @@ namespace Nonlinear_Elasticity
 
   // Constructor initializes member variables and reads the parameter file
   template <int dim, typename NumberType>
-  Solid<dim, NumberType>::Solid(const std::string &case_path)
-    : parameters(
-        Parameters::AllParameters(case_path + "nonlinear_elasticity.prm"))
+  Solid<dim, NumberType>::Solid(const std::string &case_path,
+                                const std::string &parameter_file)
+    : parameters(Parameters::AllParameters(parameter_file))
     , vol_reference(0.0)
     , vol_current(0.0)
     , triangulation(Triangulation<dim>::maximum_smoothing)
@@ -341,13 +529,36 @@ namespace Nonlinear_Elasticity
     , dofs_per_cell(fe.dofs_per_cell)
     , u_fe(first_u_component)
     , dofs_per_block(n_blocks)
-    , qf_cell(parameters.poly_degree + 2)
-    , qf_face(parameters.poly_degree + 2)
+    , qf_cell(parameters.quad_order_cell)
+    , qf_vol(parameters.quad_order_vol)
+    , qf_face(parameters.quad_order_face)
     , n_q_points(qf_cell.size())
     , n_q_points_f(qf_face.size())
+    , selective_integration(parameters.quad_order_vol !=
+                            parameters.quad_order_cell)
+    , reduced_model_online(parameters.rom_mode == "Online")
     , boundary_interface_id(7)
     , case_path(case_path)
+    , direct_solver(parameters.direct_solver)
+    , deflated_cg(parameters.deflation_vectors, false)
+    , time_series_writer(parameters.output_format, case_path)
+    , output_writer(time_series_writer.supports_concurrent_writes() ?
+                      parameters.output_queue_depth :
+                      0)
+    , interface_writer(parameters.output_format, case_path, "interface")
+    , checkpoint_writer(1)
     , timer(std::cout, TimerOutput::summary, TimerOutput::wall_times)
+    , telemetry(parameters.telemetry_format,
+                case_path + "telemetry." + parameters.telemetry_format,
+                {"Assemble linear system",
+                 "Linear solver",
+                 "Write coupling data",
+                 "preCICE advance",
+                 "Save state",
+                 "Reload state",
+                 "Output results",
+                 "Write checkpoint"},
+                {"newton_iterations", "linear_iterations"})
     , time(parameters.end_time, parameters.delta_t)
     , adapter(parameters, boundary_interface_id, true)
   {}
@@ -365,20 +576,48 @@ namespace Nonlinear_Elasticity
   void
   Solid<dim, NumberType>::run()
   {
-    // First, set up a grid and the FE system, as usual
+    // First, set up a grid and the FE system, as usual. When resuming, the
+    // mesh and the state are read from the restart file
+    if (!parameters.trace_file.empty())
+      Adapter::Trace::enable();
+    if (parameters.resume)
+      restart = std::make_unique<Adapter::CheckpointIn>(
+        case_path + parameters.checkpoint_file);
     make_grid();
     system_setup();
-    output_results();
+    if (reduced_model_online)
+      setup_reduced_system();
+    if (restart)
+      load_checkpoint();
+    else
+      output_results();
 
     // Initialize preCICE before starting the time loop
     // Here, all information concerning the coupling is passed to preCICE
+    // The read data is evaluated at the points of the face quadrature, which
+    // is used for the Neumann contribution
     adapter.initialize(dof_handler_ref,
                        std::make_shared<const MappingQ1<dim>>(),
-                       std::make_shared<const QGauss<dim - 1>>(
-                         parameters.poly_degree + 2),
+                       std::make_shared<const QGauss<dim - 1>>(qf_face),
                        total_displacement);
 
-    BlockVector<NumberType> solution_delta(dofs_per_block);
+    // In the online mode of the reduced order model, the increment is
+    // described by the reduced coordinates
+    BlockVector<NumberType> solution_delta(
+      reduced_model_online ?
+        std::vector<types::global_dof_index>(1, rom.size()) :
+        dofs_per_block);
+
+    // The phases of the coupling are measured separately, for the summary as
+    // well as for the telemetry
+    adapter.attach_timer(timer);
+    telemetry.start(timer);
+
+    // Wall time of the solution of all time steps (including the coupling
+    // iterations) in order to compare the full and the reduced order model
+    Timer        step_timer;
+    unsigned int n_solved_steps = 0;
+    step_timer.reset();
 
     // Start the time loop. Steering is done by preCICE itself
     while (adapter.precice.isCouplingOngoing())
@@ -390,15 +629,19 @@ namespace Nonlinear_Elasticity
         solution_delta = 0.0;
 
         time.increment();
+        telemetry.begin_iteration(time.get_timestep(), time.current());
 
         // Solve a the system using the Newton-Raphson algorithm
+        step_timer.start();
         solve_nonlinear_timestep(solution_delta);
-        total_displacement += solution_delta;
 
         // Update time dependent variables afterwards
-        update_acceleration(solution_delta);
-        update_velocity(solution_delta);
-        update_old_variables();
+        if (reduced_model_online)
+          update_reduced_state_variables(solution_delta);
+        else
+          update_state_variables(solution_delta);
+        step_timer.stop();
+        ++n_solved_steps;
 
         // We are interested in some timings. Here, we measure, how much time we
         // spent through coupling. In case of a parallel coupling schemes, we
@@ -419,10 +662,48 @@ namespace Nonlinear_Elasticity
         if (adapter.precice.isTimeWindowComplete() &&
             time.get_timestep() % parameters.output_interval == 0)
           output_results();
+
+        if (adapter.precice.isTimeWindowComplete())
+          output_monitoring();
+
+        // Collect the converged displacement as snapshot for the reduced
+        // order model
+        if (adapter.precice.isTimeWindowComplete() &&
+            parameters.rom_mode == "Offline")
+          snapshots.push_back(total_displacement.block(u_dof));
+
+        if (adapter.precice.isTimeWindowComplete() &&
+            parameters.checkpoint_interval > 0 &&
+            time.get_timestep() % parameters.checkpoint_interval == 0)
+          write_checkpoint();
+
+        telemetry.end_iteration(timer, adapter.precice.isTimeWindowComplete());
       }
 
     // finalizes preCICE and finishes the simulation
     adapter.precice.finalize();
+    output_writer.finalize();
+    checkpoint_writer.finalize();
+
+    const double step_time =
+      n_solved_steps > 0 ? step_timer.wall_time() / n_solved_steps : 0.;
+    if (parameters.rom_mode == "Offline")
+      compute_reduced_order_model(step_time);
+
+    if (reduced_model_online)
+      {
+        std::cout << "Wall time per time step:"
+                  << "\n\t Reduced order model: " << step_time << "s";
+        if (rom.get_full_order_step_time() > 0)
+          std::cout << "\n\t Full order model: "
+                    << rom.get_full_order_step_time() << "s"
+                    << "\n\t Speedup: "
+                    << rom.get_full_order_step_time() / step_time;
+        std::cout << std::endl;
+      }
+
+    if (Adapter::Trace::enabled())
+      Adapter::Trace::write(case_path + parameters.trace_file);
   }
 
 
@@ -438,70 +719,6 @@ namespace Nonlinear_Elasticity
       ExcMessage(
         "Setting body forces in z-direction for a two dimensional simulation has no effect"));
 
-    const std::string testcase(parameters.scenario);
-
-    Point<dim>   point_bottom, point_tip;
-    unsigned int id_flap_long_bottom, id_flap_long_top, id_flap_short_bottom,
-      id_flap_short_top, n_x, n_y, n_z;
-
-    // Assertion is done via a input pattern in the parameter class
-    if (testcase == "PF")
-      { // flap_perp
-        point_bottom =
-          dim == 3 ? Point<dim>(-0.05, 0, 0) : Point<dim>(-0.05, 0);
-        point_tip = dim == 3 ? Point<dim>(0.05, 1, 0.3) : Point<dim>(0.05, 1);
-
-        // IDs for PF
-        id_flap_long_bottom  = 0; // x direction
-        id_flap_long_top     = 1;
-        id_flap_short_bottom = 2; // y direction
-        id_flap_short_top    = 3;
-
-        n_x = 3;
-        n_y = 18;
-        n_z = 1;
-      }
-    else // FSI3, don't use condition to avoid wmaybe unitialized warning
-      {
-        point_bottom = dim == 3 ? Point<dim>(0.24899, 0.19, -0.005) :
-                                  Point<dim>(0.24899, 0.19);
-        point_tip =
-          dim == 3 ? Point<dim>(0.6, 0.21, 0.005) : Point<dim>(0.6, 0.21);
-
-        // IDs for FSI3/CSM2
-        id_flap_long_bottom  = 2; // x direction
-        id_flap_long_top     = 3;
-        id_flap_short_bottom = 0; // y direction
-        id_flap_short_top    = 1;
-
-        n_x = 25;
-        n_y = 2;
-        n_z = 1;
-      }
-
-    // Same for both scenarios, only relevant for quasi-2D
-    const unsigned int id_flap_out_of_plane_bottom = 4; // z direction
-    const unsigned int id_flap_out_of_plane_top    = 5;
-
-    const std::vector<unsigned int> repetitions =
-      dim == 2 ? std::vector<unsigned int>({n_x, n_y}) :
-                 std::vector<unsigned int>({n_x, n_y, n_z});
-
-    // Generate the mesh
-    GridGenerator::subdivided_hyper_rectangle(triangulation,
-                                              repetitions,
-                                              point_bottom,
-                                              point_tip,
-                                              /*colorize*/ true);
-
-
-    // refine all cells global_refinement times
-    const unsigned int global_refinement = 0;
-    triangulation.refine_global(global_refinement);
-
-
-    // Cell iterator for boundary conditions
-
     // The boundary ID for Neumann BCs is stored globally to
     // avoid errors.
     // Note, the selected IDs are arbitrarily chosen. They just need to be
@@ -515,28 +732,98 @@ namespace Nonlinear_Elasticity
     // This might be useful in case you want to overwrite/delete default IDs
     //    const unsigned int do_nothing_boundary_id = 2;
 
-    // Finally, set the IDs
-    for (const auto &cell : triangulation.active_cell_iterators())
-      for (const auto &face : cell->face_iterators())
-        if (face->at_boundary() == true)
+    // When resuming, the triangulation including the boundary IDs is taken
+    // from the restart file
+    if (restart)
+      restart->load_triangulation(triangulation);
+    else
+      {
+        const std::string testcase(parameters.scenario);
+
+        Point<dim>   point_bottom, point_tip;
+        unsigned int id_flap_long_bottom, id_flap_long_top,
+          id_flap_short_bottom, id_flap_short_top, n_x, n_y, n_z;
+
+        // Assertion is done via a input pattern in the parameter class
+        if (testcase == "PF")
+          { // flap_perp
+            point_bottom =
+              dim == 3 ? Point<dim>(-0.05, 0, 0) : Point<dim>(-0.05, 0);
+            point_tip =
+              dim == 3 ? Point<dim>(0.05, 1, 0.3) : Point<dim>(0.05, 1);
+
+            // IDs for PF
+            id_flap_long_bottom  = 0; // x direction
+            id_flap_long_top     = 1;
+            id_flap_short_bottom = 2; // y direction
+            id_flap_short_top    = 3;
+
+            n_x = 3;
+            n_y = 18;
+            n_z = 1;
+          }
+        else // FSI3, don't use condition to avoid wmaybe unitialized warning
           {
-            if (face->boundary_id() == id_flap_short_bottom)
-              face->set_boundary_id(clamped_id);
-            else if (face->boundary_id() == id_flap_long_bottom ||
-                     face->boundary_id() == id_flap_long_top ||
-                     face->boundary_id() == id_flap_short_top)
-              face->set_boundary_id(neumann_boundary_id);
-            // Boundaries clamped out-of-plane (z) direction
-            else if (face->boundary_id() == id_flap_out_of_plane_bottom ||
-                     face->boundary_id() == id_flap_out_of_plane_top)
-              face->set_boundary_id(out_of_plane_clamped_mesh_id);
-
-            else
-              AssertThrow(false,
-                          ExcMessage("Unknown boundary id, did "
-                                     "you set a boundary "
-                                     "condition?"))
+            point_bottom = dim == 3 ? Point<dim>(0.24899, 0.19, -0.005) :
+                                      Point<dim>(0.24899, 0.19);
+            point_tip =
+              dim == 3 ? Point<dim>(0.6, 0.21, 0.005) : Point<dim>(0.6, 0.21);
+
+            // IDs for FSI3/CSM2
+            id_flap_long_bottom  = 2; // x direction
+            id_flap_long_top     = 3;
+            id_flap_short_bottom = 0; // y direction
+            id_flap_short_top    = 1;
+
+            n_x = 25;
+            n_y = 2;
+            n_z = 1;
           }
+
+        // Same for both scenarios, only relevant for quasi-2D
+        const unsigned int id_flap_out_of_plane_bottom = 4; // z direction
+        const unsigned int id_flap_out_of_plane_top    = 5;
+
+        const std::vector<unsigned int> repetitions =
+          dim == 2 ? std::vector<unsigned int>({n_x, n_y}) :
+                     std::vector<unsigned int>({n_x, n_y, n_z});
+
+        // Generate the mesh
+        GridGenerator::subdivided_hyper_rectangle(triangulation,
+                                                  repetitions,
+                                                  point_bottom,
+                                                  point_tip,
+                                                  /*colorize*/ true);
+
+
+        // refine all cells global_refinement times
+        const unsigned int global_refinement = 0;
+        triangulation.refine_global(global_refinement);
+
+        // Finally, set the IDs
+        for (const auto &cell : triangulation.active_cell_iterators())
+          for (const auto &face : cell->face_iterators())
+            if (face->at_boundary() == true)
+              {
+                if (face->boundary_id() == id_flap_short_bottom)
+                  face->set_boundary_id(clamped_id);
+                else if (face->boundary_id() == id_flap_long_bottom ||
+                         face->boundary_id() == id_flap_long_top ||
+                         face->boundary_id() == id_flap_short_top)
+                  face->set_boundary_id(neumann_boundary_id);
+                // Boundaries clamped out-of-plane (z) direction
+                else if (face->boundary_id() == id_flap_out_of_plane_bottom ||
+                         face->boundary_id() == id_flap_out_of_plane_top)
+                  face->set_boundary_id(out_of_plane_clamped_mesh_id);
+
+                else
+                  AssertThrow(false,
+                              ExcMessage("Unknown boundary id, did "
+                                         "you set a boundary "
+                                         "condition?"))
+              }
+      }
+
     // Check, whether the given IDs are mutually exclusive
     AssertThrow(
       clamped_id != neumann_boundary_id,
@@ -568,11 +855,30 @@ namespace Nonlinear_Elasticity
     // The DOF handler is then initialised and we renumber the grid in an
     // efficient manner. We also record the number of DOFs per block.
     dof_handler_ref.distribute_dofs(fe);
-    DoFRenumbering::Cuthill_McKee(dof_handler_ref);
-    DoFRenumbering::component_wise(dof_handler_ref, block_component);
+    // When resuming, the DoFs are numbered as in the restart file, such that
+    // the stored vectors can be read directly
+    if (restart)
+      restart->load_dof_numbering(dof_handler_ref);
+    else
+      {
+        Adapter::renumber_dofs(dof_handler_ref, parameters.dof_renumbering);
+        DoFRenumbering::component_wise(dof_handler_ref, block_component);
+        if (parameters.matrix_format == "Node-blocked")
+          Adapter::make_node_contiguous(dof_handler_ref);
+      }
     dofs_per_block =
       DoFTools::count_dofs_per_fe_block(dof_handler_ref, block_component);
 
+    // The assembly relies on all shape functions belonging to the
+    // displacement block
+    component_of_dof.resize(dofs_per_cell);
+    for (unsigned int k = 0; k < dofs_per_cell; ++k)
+      {
+        Assert(fe.system_to_base_index(k).first.first == u_dof,
+               ExcInternalError());
+        component_of_dof[k] = fe.system_to_component_index(k).first;
+      }
+
     std::cout.imbue(std::locale(""));
     std::cout << "Triangulation:"
               << "\n\t Number of active cells: "
@@ -580,6 +886,10 @@ namespace Nonlinear_Elasticity
               << "\n\t Polynomial degree: " << parameters.poly_degree
               << "\n\t Number of degrees of freedom: "
               << dof_handler_ref.n_dofs() << std::endl;
+    if (selective_integration)
+      std::cout << "\t Selective integration: " << parameters.quad_order_vol
+                << " volumetric and " << parameters.quad_order_cell
+                << " isochoric Gauss points per direction" << std::endl;
 
     tangent_matrix.clear();
     {
@@ -601,17 +911,30 @@ namespace Nonlinear_Elasticity
 
     // Setup the sparsity pattern and tangent matrixI
     tangent_matrix.reinit(sparsity_pattern);
+    mass_matrix.reinit(sparsity_pattern);
+    if (parameters.matrix_format == "Node-blocked")
+      {
+        node_block_matrix.reinit(sparsity_pattern.block(u_dof, u_dof));
+        // The block format is a copy of the tangent matrix, which is kept
+        std::cout << "Node blocked matrix: "
+                  << node_block_matrix.memory_consumption()
+                  << " bytes in addition to the CSR matrix ("
+                  << tangent_matrix.block(u_dof, u_dof).memory_consumption() +
+                       sparsity_pattern.block(u_dof, u_dof).memory_consumption()
+                  << " bytes)" << std::endl;
+      }
 
     // We then set up storage vectors. Here, one vector for each time dependent
     // variable is needed
     system_rhs.reinit(dofs_per_block);
     system_rhs.collect_sizes();
+    body_force_vector.reinit(system_rhs);
+    inertia_force.reinit(system_rhs);
 
     total_displacement.reinit(dofs_per_block);
     total_displacement.collect_sizes();
 
     // Copy initialization
-    total_displacement_old.reinit(total_displacement);
     velocity.reinit(total_displacement);
     velocity_old.reinit(total_displacement);
     // TODO: Estimate acc properly in case of body forces
@@ -620,15 +943,71 @@ namespace Nonlinear_Elasticity
 
     // Alias: Container, which holds references for all time dependent variables
     // to enable a compact notation
-    state_variables = {&total_displacement,
-                       &total_displacement_old,
-                       &velocity,
-                       &velocity_old,
-                       &acceleration,
-                       &acceleration_old};
+    state_variables = {&total_displacement, &velocity_old, &acceleration_old};
 
     setup_qph();
 
+    newton_update.reinit(dofs_per_block);
+
+    // The Dirichlet constraints do not change throughout the simulation, so
+    // they are built only once. We also use them to condense the mass matrix
+    // and the body force vector
+    make_constraints();
+    assemble_mass_matrix();
+    if (parameters.matrix_layout)
+      Adapter::print_matrix_layout(mass_matrix.block(u_dof, u_dof));
+
+    unconstrained_dofs.clear();
+    for (types::global_dof_index i = 0; i < dof_handler_ref.n_dofs(); ++i)
+      if (!constraints.is_constrained(i))
+        unconstrained_dofs.push_back(i);
+
+    if (parameters.dof_renumbering == "Hilbert")
+      assembly_cells = Adapter::hilbert_cell_order(dof_handler_ref);
+    else
+      {
+        assembly_cells.clear();
+        for (const auto &cell : dof_handler_ref.active_cell_iterators())
+          assembly_cells.push_back(cell);
+      }
+
+    if (parameters.assembly_scheme == "Colored")
+      {
+        colored_cells =
+          Adapter::make_colored_cells(dof_handler_ref, constraints);
+        Adapter::sort_colored_cells(colored_cells, assembly_cells);
+        std::cout << "Assembly colors: " << colored_cells.size() << std::endl;
+      }
+
+    if (parameters.output_geometry == "Reference" ||
+        time_series_writer.reference_geometry())
+      reference_output = std::make_unique<Adapter::CachedDataOut<dim>>(
+        dof_handler_ref,
+        StaticMappingQ1<dim>::mapping,
+        std::make_shared<Postprocessor<dim>>(),
+        n_output_subdivisions());
+
+    if (!parameters.probe_points.empty())
+      {
+        std::vector<Point<dim>> points;
+        for (const auto &coordinates : parameters.probe_points)
+          {
+            AssertThrow(coordinates.size() == dim,
+                        ExcMessage("The probe points need to have " +
+                                   std::to_string(dim) + " coordinates"));
+            Point<dim> point;
+            for (unsigned int d = 0; d < dim; ++d)
+              point[d] = coordinates[d];
+            points.push_back(point);
+          }
+        probes = std::make_unique<Adapter::PointProbes<dim>>(
+          dof_handler_ref,
+          StaticMappingQ1<dim>::mapping,
+          points,
+          case_path + parameters.probe_file,
+          /*append = */ parameters.resume);
+      }
+
     timer.leave_subsection();
   }
 
@@ -665,11 +1044,12 @@ namespace Nonlinear_Elasticity
   Solid<dim, NumberType>::solve_nonlinear_timestep(
     BlockVector<double> &solution_delta)
   {
+    const Adapter::TraceScope trace("Solve nonlinear timestep");
     std::cout << std::endl
               << "Timestep " << time.get_timestep() << " @ " << std::fixed
               << time.current() << "s" << std::endl;
 
-    BlockVector<double> newton_update(dofs_per_block);
+    newton_update = 0.0;
 
     error_residual.reset();
     error_residual_0.reset();
@@ -691,12 +1071,18 @@ namespace Nonlinear_Elasticity
         std::cout << " " << std::setw(2) << newton_iteration << " "
                   << std::flush;
 
-        make_constraints(newton_iteration);
-        // Acceleration is evaluated at t_n+1 and therefore updated in each
-        // lineraized step
-        update_acceleration(solution_delta);
-
-        assemble_system(solution_delta, acceleration);
+        // Acceleration is evaluated at t_n+1-alpha_m and therefore updated in
+        // each lineraized step
+        if (reduced_model_online)
+          {
+            update_reduced_acceleration(solution_delta);
+            assemble_reduced_system(solution_delta);
+          }
+        else
+          {
+            update_acceleration(solution_delta);
+            assemble_system(solution_delta, acceleration);
+          }
 
         // Residual error = rhs error
         get_error_residual(error_residual);
@@ -723,7 +1109,9 @@ namespace Nonlinear_Elasticity
 
         // Solve the system
         const std::pair<unsigned int, double> lin_solver_output =
-          solve_linear_system(newton_update);
+          reduced_model_online ? solve_reduced_system(newton_update) :
+                                 solve_linear_system(newton_update);
+        telemetry.count("linear_iterations", lin_solver_output.first);
 
         // Update errors
         get_error_update(newton_update, error_update);
@@ -749,6 +1137,7 @@ namespace Nonlinear_Elasticity
 
     AssertThrow(newton_iteration < parameters.max_iterations_NR,
                 ExcMessage("No convergence in nonlinear solver!"));
+    telemetry.count("newton_iterations", newton_iteration);
   }
 
 
@@ -797,19 +1186,15 @@ namespace Nonlinear_Elasticity
 
   // Determine the true residual error for the problem. That is, determine the
   // error in the residual for the unconstrained degrees of freedom. Note that
-  // to do so, we need to ignore constrained DOFs by setting the residual in
-  // these vector components to zero.
+  // to do so, we need to ignore constrained DOFs, which is done using the
+  // precomputed list of unconstrained DOFs. For the reduced order model, the
+  // projected residual is used instead.
   template <int dim, typename NumberType>
   void
-  Solid<dim, NumberType>::get_error_residual(Errors &error_residual)
+  Solid<dim, NumberType>::get_error_residual(Errors &error_residual) const
   {
-    BlockVector<double> error_res(dofs_per_block);
-
-    for (unsigned int i = 0; i < dof_handler_ref.n_dofs(); ++i)
-      if (!constraints.is_constrained(i))
-        error_res(i) = system_rhs(i);
-
-    error_residual.u = error_res.block(u_dof).l2_norm();
+    error_residual.u = reduced_model_online ? reduced_rhs.l2_norm() :
+                                              unconstrained_l2_norm(system_rhs);
   }
 
 
@@ -818,60 +1203,102 @@ namespace Nonlinear_Elasticity
   void
   Solid<dim, NumberType>::get_error_update(
     const BlockVector<double> &newton_update,
-    Errors &                   error_update)
+    Errors &                   error_update) const
   {
-    BlockVector<double> error_ud(dofs_per_block);
-    for (unsigned int i = 0; i < dof_handler_ref.n_dofs(); ++i)
-      if (!constraints.is_constrained(i))
-        error_ud(i) = newton_update(i);
-
-    error_update.u = error_ud.block(u_dof).l2_norm();
+    error_update.u = reduced_model_online ?
+                       newton_update.l2_norm() :
+                       unconstrained_l2_norm(newton_update);
   }
 
 
-  // Returns the total displacement needed during assembly
+
   template <int dim, typename NumberType>
-  BlockVector<double>
-  Solid<dim, NumberType>::get_total_solution(
-    const BlockVector<double> &solution_delta) const
+  double
+  Solid<dim, NumberType>::unconstrained_l2_norm(
+    const BlockVector<double> &vector) const
   {
-    BlockVector<double> solution_total(total_displacement);
-    solution_total += solution_delta;
-    return solution_total;
+    double norm_sqr = 0.0;
+    for (const types::global_dof_index i : unconstrained_dofs)
+      norm_sqr += vector(i) * vector(i);
+
+    return std::sqrt(norm_sqr);
   }
 
 
-  // Update the acceleration according to Newmarks method
+  // Update the acceleration according to Newmarks method. The acceleration is
+  // evaluated at t_n+1-alpha_m, i.e., (1-alpha_m) a_n+1 + alpha_m a_n, which is
+  // the one needed for the inertia forces. The update is done in a single
+  // threaded and vectorized sweep over the vectors.
   template <int dim, typename NumberType>
   void
   Solid<dim, NumberType>::update_acceleration(
-    BlockVector<double> &displacement_delta)
+    const BlockVector<double> &displacement_delta)
   {
-    acceleration.equ(alpha_1, displacement_delta);
-    acceleration.add(-alpha_2, velocity_old, -alpha_3, acceleration_old);
-  }
+    const double c_delta = (1. - alpha_m) * alpha_1;
+    const double c_v_old = (1. - alpha_m) * alpha_2;
+    const double c_a_old = (1. - alpha_m) * alpha_3 - alpha_m;
 
-
-  // Update the velocity according to Newmarks method
-  template <int dim, typename NumberType>
-  void
-  Solid<dim, NumberType>::update_velocity(
-    BlockVector<double> &displacement_delta)
-  {
-    velocity.equ(alpha_4, displacement_delta);
-    velocity.add(alpha_5, velocity_old, alpha_6, acceleration_old);
+    for (unsigned int b = 0; b < displacement_delta.n_blocks(); ++b)
+      {
+        const double *delta = displacement_delta.block(b).begin();
+        const double *v_old = velocity_old.block(b).begin();
+        const double *a_old = acceleration_old.block(b).begin();
+        double *      a     = acceleration.block(b).begin();
+
+        parallel::apply_to_subranges(
+          types::global_dof_index(0),
+          displacement_delta.block(b).size(),
+          [&](const types::global_dof_index begin,
+              const types::global_dof_index end) {
+            DEAL_II_OPENMP_SIMD_PRAGMA
+            for (types::global_dof_index i = begin; i < end; ++i)
+              a[i] = c_delta * delta[i] - c_v_old * v_old[i] -
+                     c_a_old * a_old[i];
+          },
+          newmark_grain_size);
+      }
   }
 
 
-  // Update variables related to old time steps
+  // Update all time dependent variables at the end of a time step according
+  // to Newmarks method. The displacement, the velocity and the acceleration
+  // are updated in a single fused sweep. Afterwards, the new and old velocity
+  // and acceleration are swapped, so that the old vectors hold the converged
+  // state of the current time step without copying any data.
   template <int dim, typename NumberType>
   void
-  Solid<dim, NumberType>::update_old_variables()
-
+  Solid<dim, NumberType>::update_state_variables(
+    const BlockVector<double> &displacement_delta)
   {
-    total_displacement_old = total_displacement;
-    velocity_old           = velocity;
-    acceleration_old       = acceleration;
+    for (unsigned int b = 0; b < displacement_delta.n_blocks(); ++b)
+      {
+        const double *delta = displacement_delta.block(b).begin();
+        const double *v_old = velocity_old.block(b).begin();
+        const double *a_old = acceleration_old.block(b).begin();
+        double *      u     = total_displacement.block(b).begin();
+        double *      v     = velocity.block(b).begin();
+        double *      a     = acceleration.block(b).begin();
+
+        parallel::apply_to_subranges(
+          types::global_dof_index(0),
+          displacement_delta.block(b).size(),
+          [&](const types::global_dof_index begin,
+              const types::global_dof_index end) {
+            DEAL_II_OPENMP_SIMD_PRAGMA
+            for (types::global_dof_index i = begin; i < end; ++i)
+              {
+                u[i] += delta[i];
+                a[i] = alpha_1 * delta[i] - alpha_2 * v_old[i] -
+                       alpha_3 * a_old[i];
+                v[i] = alpha_4 * delta[i] + alpha_5 * v_old[i] +
+                       alpha_6 * a_old[i];
+              }
+          },
+          newmark_grain_size);
+      }
+
+    velocity.swap(velocity_old);
+    acceleration.swap(acceleration_old);
   }
 
 
@@ -906,86 +1333,122 @@ namespace Nonlinear_Elasticity
       }
     };
 
+    // The PointData object stores the kinematic quantities, the material
+    // response and the shape function gradients in the current configuration
+    // at all points of one quadrature rule. They are evaluated in a single
+    // batch per cell.
+    struct PointData_ASM
+    {
+      FEValues<dim> fe_values_ref;
+
+      std::vector<Tensor<2, dim, NumberType>>              solution_grads_u;
+      std::vector<std::vector<Tensor<2, dim, NumberType>>> grad_Nx;
+      std::vector<std::vector<SymmetricTensor<2, dim, NumberType>>>
+        symm_grad_Nx;
+
+      std::vector<NumberType>                          det_F;
+      std::vector<SymmetricTensor<2, dim, NumberType>> b_bar;
+      std::vector<SymmetricTensor<2, dim, NumberType>> tau;
+      std::vector<SymmetricTensor<4, dim, NumberType>> Jc;
+
+      PointData_ASM(const FiniteElement<dim> &fe_cell,
+                    const QGauss<dim> &       qf,
+                    const UpdateFlags         uf)
+        : fe_values_ref(fe_cell, qf, uf)
+        , solution_grads_u(qf.size())
+        , grad_Nx(qf.size(),
+                  std::vector<Tensor<2, dim, NumberType>>(
+                    fe_cell.dofs_per_cell))
+        , symm_grad_Nx(qf.size(),
+                       std::vector<SymmetricTensor<2, dim, NumberType>>(
+                         fe_cell.dofs_per_cell))
+        , det_F(qf.size())
+        , b_bar(qf.size())
+        , tau(qf.size())
+        , Jc(qf.size())
+      {}
+
+      PointData_ASM(const PointData_ASM &rhs)
+        : fe_values_ref(rhs.fe_values_ref.get_fe(),
+                        rhs.fe_values_ref.get_quadrature(),
+                        rhs.fe_values_ref.get_update_flags())
+        , solution_grads_u(rhs.solution_grads_u)
+        , grad_Nx(rhs.grad_Nx)
+        , symm_grad_Nx(rhs.symm_grad_Nx)
+        , det_F(rhs.det_F)
+        , b_bar(rhs.b_bar)
+        , tau(rhs.tau)
+        , Jc(rhs.Jc)
+      {}
+    };
+
     // On the other hand, the ScratchData object stores the larger objects such
     // as the shape-function values array (Nx) and a shape function gradient and
     // symmetric gradient vector which we will use during the assembly.
     struct ScratchData_ASM
     {
-      const BlockVector<double> &             solution_total;
-      const BlockVector<double> &             acceleration;
-      std::vector<Tensor<2, dim, NumberType>> solution_grads_u_total;
-      std::vector<Tensor<1, dim, NumberType>> local_acceleration;
+      // The total displacement is not assembled into a separate vector, but
+      // evaluated as u_n + delta on the local DoF values of each cell
+      const BlockVector<double> &total_displacement;
+      const BlockVector<double> &solution_delta;
+      Vector<double>             local_solution_total;
+      Vector<double>             local_solution_delta;
+
+      // Point data of the cell quadrature and, in case of a selective
+      // integration, of the reduced quadrature for the volumetric part
+      PointData_ASM cell_data;
+      PointData_ASM vol_data;
 
-      FEValues<dim>     fe_values_ref;
       FEFaceValues<dim> fe_face_values_ref;
+      // Displacement gradients at the face quadrature points, needed for the
+      // pull back of the coupling data
+      std::vector<Tensor<2, dim, NumberType>> solution_grads_u_face;
 
-      std::vector<std::vector<Tensor<2, dim, NumberType>>> grad_Nx;
-      std::vector<std::vector<SymmetricTensor<2, dim, NumberType>>>
-        symm_grad_Nx;
-
-      std::vector<std::vector<Tensor<1, dim, NumberType>>> shape_value;
+      // Contractions Jc : symm_grad_Nx[j] and tau * grad_Nx[j] of the current
+      // quadrature point
+      std::vector<SymmetricTensor<2, dim, NumberType>> Jc_symm_grad_Nx;
+      std::vector<Tensor<1, dim, NumberType>>          tau_grad_Nx;
 
       ScratchData_ASM(const FiniteElement<dim> & fe_cell,
                       const QGauss<dim> &        qf_cell,
+                      const QGauss<dim> &        qf_vol,
                       const UpdateFlags          uf_cell,
                       const QGauss<dim - 1> &    qf_face,
                       const UpdateFlags          uf_face,
-                      const BlockVector<double> &solution_total,
-                      const BlockVector<double> &acceleration)
-        : solution_total(solution_total)
-        , acceleration(acceleration)
-        , solution_grads_u_total(qf_cell.size())
-        , local_acceleration(qf_cell.size())
-        , fe_values_ref(fe_cell, qf_cell, uf_cell)
+                      const BlockVector<double> &total_displacement,
+                      const BlockVector<double> &solution_delta)
+        : total_displacement(total_displacement)
+        , solution_delta(solution_delta)
+        , local_solution_total(fe_cell.dofs_per_cell)
+        , local_solution_delta(fe_cell.dofs_per_cell)
+        , cell_data(fe_cell, qf_cell, uf_cell)
+        , vol_data(fe_cell, qf_vol, uf_cell)
         , fe_face_values_ref(fe_cell, qf_face, uf_face)
-        , grad_Nx(qf_cell.size(),
-                  std::vector<Tensor<2, dim, NumberType>>(
-                    fe_cell.dofs_per_cell))
-        , symm_grad_Nx(qf_cell.size(),
-                       std::vector<SymmetricTensor<2, dim, NumberType>>(
-                         fe_cell.dofs_per_cell))
-        , shape_value(qf_cell.size(),
-                      std::vector<Tensor<1, dim, NumberType>>(
-                        fe_cell.dofs_per_cell))
+        , solution_grads_u_face(qf_face.size())
+        , Jc_symm_grad_Nx(fe_cell.dofs_per_cell)
+        , tau_grad_Nx(fe_cell.dofs_per_cell)
       {}
 
       ScratchData_ASM(const ScratchData_ASM &rhs)
-        : solution_total(rhs.solution_total)
-        , acceleration(rhs.acceleration)
-        , solution_grads_u_total(rhs.solution_grads_u_total)
-        , local_acceleration(rhs.local_acceleration)
-        , fe_values_ref(rhs.fe_values_ref.get_fe(),
-                        rhs.fe_values_ref.get_quadrature(),
-                        rhs.fe_values_ref.get_update_flags())
+        : total_displacement(rhs.total_displacement)
+        , solution_delta(rhs.solution_delta)
+        , local_solution_total(rhs.local_solution_total)
+        , local_solution_delta(rhs.local_solution_delta)
+        , cell_data(rhs.cell_data)
+        , vol_data(rhs.vol_data)
         , fe_face_values_ref(rhs.fe_face_values_ref.get_fe(),
                              rhs.fe_face_values_ref.get_quadrature(),
                              rhs.fe_face_values_ref.get_update_flags())
-        , grad_Nx(rhs.grad_Nx)
-        , symm_grad_Nx(rhs.symm_grad_Nx)
-        , shape_value(rhs.shape_value)
+        , solution_grads_u_face(rhs.solution_grads_u_face)
+        , Jc_symm_grad_Nx(rhs.Jc_symm_grad_Nx)
+        , tau_grad_Nx(rhs.tau_grad_Nx)
       {}
 
       void
       reset()
       {
-        const unsigned int n_q_points = fe_values_ref.get_quadrature().size();
-        const unsigned int n_dofs_per_cell = fe_values_ref.dofs_per_cell;
-        for (unsigned int q_point = 0; q_point < n_q_points; ++q_point)
-          {
-            Assert(grad_Nx[q_point].size() == n_dofs_per_cell,
-                   ExcInternalError());
-            Assert(symm_grad_Nx[q_point].size() == n_dofs_per_cell,
-                   ExcInternalError());
-
-            solution_grads_u_total[q_point] = Tensor<2, dim, NumberType>();
-            for (unsigned int k = 0; k < n_dofs_per_cell; ++k)
-              {
-                grad_Nx[q_point][k] = Tensor<2, dim, NumberType>();
-                symm_grad_Nx[q_point][k] =
-                  SymmetricTensor<2, dim, NumberType>();
-                shape_value[q_point][k] = Tensor<1, dim, NumberType>();
-              }
-          }
+        local_solution_total = 0.0;
+        local_solution_delta = 0.0;
       }
     };
     // Due to the C++ specialization rules, we need one more level of
@@ -1000,14 +1463,42 @@ namespace Nonlinear_Elasticity
       ScratchData_ASM &                                     scratch,
       PerTaskData_ASM &                                     data)
     {
+      const Adapter::TraceScope trace("Assemble cell");
       assemble_system_tangent_residual_one_cell(cell, scratch, data);
       assemble_neumann_contribution_one_cell(cell, scratch, data);
     }
 
+    // Assembles the contributions of one cell to the reduced order model. The
+    // internal forces are scaled with the cubature weight of the cell and
+    // skipped for a zero weight. The Neumann contribution is not
+    // hyper-reduced, but integrated exactly on all interface cells.
+    void
+    assemble_reduced_one_cell(
+      const typename DoFHandler<dim>::active_cell_iterator &cell,
+      const double                                          weight,
+      const bool                                            neumann,
+      ScratchData_ASM &                                     scratch,
+      PerTaskData_ASM &                                     data)
+    {
+      const Adapter::TraceScope trace("Assemble reduced cell");
+      if (weight > 0)
+        {
+          assemble_system_tangent_residual_one_cell(cell, scratch, data);
+          data.cell_matrix *= weight;
+          data.cell_rhs *= weight;
+        }
+      else
+        reinit_local_solution(cell, scratch, data);
+
+      if (neumann)
+        assemble_neumann_contribution_one_cell(cell, scratch, data);
+    }
+
     // This function adds the local contribution to the system matrix.
     void
     copy_local_to_global_ASM(const PerTaskData_ASM &data)
     {
+      const Adapter::TraceScope trace("Copy local to global");
       const AffineConstraints<double> &constraints = data.solid->constraints;
       BlockSparseMatrix<double> &      tangent_matrix =
         const_cast<Solid<dim, NumberType> *>(data.solid)->tangent_matrix;
@@ -1024,6 +1515,26 @@ namespace Nonlinear_Elasticity
     // This function needs to exist in the base class for Workstream to work
     // with a reference to the base class.
   protected:
+    // Resets the local data and gathers the displacement u_n + (1-alpha_f)
+    // delta at t_n+1-alpha_f on the local DoF values
+    void
+    reinit_local_solution(
+      const typename DoFHandler<dim>::active_cell_iterator &cell,
+      ScratchData_ASM &                                     scratch,
+      PerTaskData_ASM &                                     data)
+    {
+      data.reset();
+      scratch.reset();
+      cell->get_dof_indices(data.local_dof_indices);
+
+      cell->get_dof_values(scratch.total_displacement,
+                           scratch.local_solution_total);
+      cell->get_dof_values(scratch.solution_delta,
+                           scratch.local_solution_delta);
+      scratch.local_solution_total.add(1. - data.solid->alpha_f,
+                                       scratch.local_solution_delta);
+    }
+
     virtual void
     assemble_system_tangent_residual_one_cell(
       const typename DoFHandler<dim>::active_cell_iterator & /*cell*/,
@@ -1042,17 +1553,21 @@ namespace Nonlinear_Elasticity
       ScratchData_ASM &                                     scratch,
       PerTaskData_ASM &                                     data)
     {
-      const unsigned int & n_q_points_f  = data.solid->n_q_points_f;
-      const unsigned int & dofs_per_cell = data.solid->dofs_per_cell;
-      const FESystem<dim> &fe            = data.solid->fe;
-      const unsigned int & u_dof         = data.solid->u_dof;
-      const unsigned int & interf_id     = data.solid->boundary_interface_id;
-      const auto &         adapter       = data.solid->adapter;
+      const unsigned int &n_q_points_f  = data.solid->n_q_points_f;
+      const unsigned int &dofs_per_cell = data.solid->dofs_per_cell;
+      const unsigned int &interf_id     = data.solid->boundary_interface_id;
+      const auto &        adapter       = data.solid->adapter;
+      const FEValuesExtractors::Vector &u_fe = data.solid->u_fe;
+      const std::vector<unsigned int> & component_of_dof =
+        data.solid->component_of_dof;
 
       for (const auto &face : cell->face_iterators())
         if (face->at_boundary() == true && face->boundary_id() == interf_id)
           {
             scratch.fe_face_values_ref.reinit(cell, face);
+            scratch.fe_face_values_ref[u_fe]
+              .get_function_gradients_from_local_dof_values(
+                scratch.local_solution_total, scratch.solution_grads_u_face);
 
             const unsigned int precice_id = adapter.get_block_data_id(
               cell->face_index(cell->face_iterator_to_index(face)));
@@ -1073,29 +1588,22 @@ namespace Nonlinear_Elasticity
                 // coniguration
                 const Tensor<2, dim, NumberType> F =
                   Physics::Elasticity::Kinematics::F(
-                    scratch.solution_grads_u_total[f_q_point]);
+                    scratch.solution_grads_u_face[f_q_point]);
 
                 const Tensor<1, dim, NumberType> referential_stress =
                   Physics::Transformations::Covariant::pull_back(precice_data,
                                                                  F);
 
+                const double JxW = scratch.fe_face_values_ref.JxW(f_q_point);
+
                 for (unsigned int i = 0; i < dofs_per_cell; ++i)
                   {
-                    const unsigned int i_group =
-                      fe.system_to_base_index(i).first.first;
-
-                    if (i_group == u_dof)
-                      {
-                        const unsigned int component_i =
-                          fe.system_to_component_index(i).first;
-                        const double Ni =
-                          scratch.fe_face_values_ref.shape_value(i, f_q_point);
-                        const double JxW =
-                          scratch.fe_face_values_ref.JxW(f_q_point);
-
-                        data.cell_rhs(i) +=
-                          (Ni * referential_stress[component_i]) * JxW;
-                      }
+                    const unsigned int component_i = component_of_dof[i];
+                    const double       Ni =
+                      scratch.fe_face_values_ref.shape_value(i, f_q_point);
+
+                    data.cell_rhs(i) +=
+                      (Ni * referential_stress[component_i]) * JxW;
                   }
               }
           }
@@ -1119,20 +1627,8 @@ namespace Nonlinear_Elasticity
       PerTaskData_ASM &                                     data)
     {
       // Aliases for data referenced from the Solid class
-      const unsigned int & n_q_points           = data.solid->n_q_points;
-      const unsigned int & dofs_per_cell        = data.solid->dofs_per_cell;
-      const FESystem<dim> &fe                   = data.solid->fe;
-      const unsigned int & u_dof                = data.solid->u_dof;
-      const FEValuesExtractors::Vector &u_fe    = data.solid->u_fe;
-      const double &                    alpha_1 = data.solid->alpha_1;
-
-      // Define const force vector for gravity
-      const Tensor<1, 3, double> body_force = data.solid->body_force;
-
-      data.reset();
-      scratch.reset();
-      scratch.fe_values_ref.reinit(cell);
-      cell->get_dof_indices(data.local_dof_indices);
+      const unsigned int &n_q_points    = data.solid->n_q_points;
+      const unsigned int &dofs_per_cell = data.solid->dofs_per_cell;
 
       const std::vector<std::shared_ptr<const PointHistory<dim, NumberType>>>
         lqph = const_cast<const Solid<dim, NumberType> *>(data.solid)
@@ -1141,141 +1637,169 @@ namespace Nonlinear_Elasticity
 
       // We first need to find the solution gradients at quadrature points
       // inside the current cell and then we update each local QP using the
-      // displacement gradient:
-      scratch.fe_values_ref[u_fe].get_function_gradients(
-        scratch.solution_total, scratch.solution_grads_u_total);
+      // displacement gradient. The displacement u_n + (1-alpha_f) delta at
+      // t_n+1-alpha_f is only formed on the local DoF values:
+      this->reinit_local_solution(cell, scratch, data);
+
+      // The material parameters are constant in the whole domain, so the
+      // material of the first quadrature point is used for all points. In
+      // case of a selective integration, the isochoric part is integrated with
+      // the cell quadrature and the volumetric part with the reduced
+      // quadrature.
+      if (data.solid->selective_integration)
+        {
+          assemble_point_data(cell,
+                              *lqph[0],
+                              Contribution::isochoric,
+                              scratch.cell_data,
+                              scratch,
+                              data);
+          assemble_point_data(cell,
+                              *lqph[0],
+                              Contribution::volumetric,
+                              scratch.vol_data,
+                              scratch,
+                              data);
+        }
+      else
+        assemble_point_data(cell,
+                            *lqph[0],
+                            Contribution::full,
+                            scratch.cell_data,
+                            scratch,
+                            data);
+
+      // Copy triangular matrix
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int j = i + 1; j < dofs_per_cell; ++j)
+          data.cell_matrix(i, j) = data.cell_matrix(j, i);
+    }
+
+  private:
+    using Contribution = typename Material_Compressible_Neo_Hook_One_Field<
+      dim,
+      NumberType>::Contribution;
+    using PointData_ASM =
+      typename Assembler_Base<dim, NumberType>::PointData_ASM;
+
+    // Evaluates the requested part of the material law at all points of
+    // point_data and adds the resulting contributions to the cell residual
+    // and the lower half of the cell tangent
+    void
+    assemble_point_data(
+      const typename DoFHandler<dim>::active_cell_iterator &cell,
+      const PointHistory<dim, NumberType> &                 qph,
+      const Contribution                                    contribution,
+      PointData_ASM &                                       point_data,
+      ScratchData_ASM &                                     scratch,
+      PerTaskData_ASM &                                     data)
+    {
+      // Aliases for data referenced from the Solid class
+      const unsigned int &dofs_per_cell = data.solid->dofs_per_cell;
+      const FEValuesExtractors::Vector &u_fe = data.solid->u_fe;
+      const std::vector<unsigned int> & component_of_dof =
+        data.solid->component_of_dof;
 
-      scratch.fe_values_ref[u_fe].get_function_values(
-        scratch.acceleration, scratch.local_acceleration);
+      FEValues<dim> &    fe_values_ref = point_data.fe_values_ref;
+      const unsigned int n_q_points    = fe_values_ref.n_quadrature_points;
 
-      // Const in the whole domain, so we call it once for each cell
-      const double rho = lqph[0]->get_rho();
+      fe_values_ref.reinit(cell);
+      fe_values_ref[u_fe].get_function_gradients_from_local_dof_values(
+        scratch.local_solution_total, point_data.solution_grads_u);
 
-      // Now we build the local cell stiffness matrix. Since the global and
-      // local system matrices are symmetric, we can exploit this property by
-      // building only the lower half of the local matrix and copying the values
-      // to the upper half.
+      // First, we compute the kinematic quantities and the shape function
+      // gradients with respect to the current configuration at all quadrature
+      // points of the cell.
       for (unsigned int q_point = 0; q_point < n_q_points; ++q_point)
         {
-          // In doing so, we first extract some configuration dependent
-          // variables from our QPH history objects for the current quadrature
-          // point.
-          // Get kinematic variables
           const Tensor<2, dim, NumberType> &grad_u =
-            scratch.solution_grads_u_total[q_point];
-
-          const Tensor<1, dim, NumberType> &acc =
-            scratch.local_acceleration[q_point];
+            point_data.solution_grads_u[q_point];
 
           const Tensor<2, dim, NumberType> F =
             Physics::Elasticity::Kinematics::F(grad_u);
           const NumberType                 det_F = determinant(F);
           const Tensor<2, dim, NumberType> F_bar =
             Physics::Elasticity::Kinematics::F_iso(F);
-          const SymmetricTensor<2, dim, NumberType> b_bar =
-            Physics::Elasticity::Kinematics::b(F_bar);
           const Tensor<2, dim, NumberType> F_inv = invert(F);
           Assert(det_F > NumberType(0.0), ExcInternalError());
 
+          point_data.det_F[q_point] = det_F;
+          point_data.b_bar[q_point] = Physics::Elasticity::Kinematics::b(F_bar);
 
           // Update scratch data
           for (unsigned int k = 0; k < dofs_per_cell; ++k)
             {
-              const unsigned int k_group =
-                fe.system_to_base_index(k).first.first;
-
-              if (k_group == u_dof)
-                {
-                  scratch.grad_Nx[q_point][k] =
-                    scratch.fe_values_ref[u_fe].gradient(k, q_point) * F_inv;
-                  scratch.symm_grad_Nx[q_point][k] =
-                    symmetrize(scratch.grad_Nx[q_point][k]);
-                  scratch.shape_value[q_point][k] =
-                    scratch.fe_values_ref[u_fe].value(k, q_point);
-                }
-              else
-                Assert(k_group <= u_dof, ExcInternalError());
+              point_data.grad_Nx[q_point][k] =
+                fe_values_ref[u_fe].gradient(k, q_point) * F_inv;
+              point_data.symm_grad_Nx[q_point][k] =
+                symmetrize(point_data.grad_Nx[q_point][k]);
             }
+        }
 
-          // Get material contributions
-          const SymmetricTensor<2, dim, NumberType> tau =
-            lqph[q_point]->get_tau(det_F, b_bar);
-          const SymmetricTensor<4, dim, NumberType> Jc =
-            lqph[q_point]->get_Jc(det_F, b_bar);
-          const Tensor<2, dim, NumberType> tau_ns(tau);
+      // Get material contributions for all quadrature points at once
+      qph.get_tau_Jc(point_data.det_F,
+                     point_data.b_bar,
+                     point_data.tau,
+                     point_data.Jc,
+                     contribution);
 
+      // Now we build the local cell stiffness matrix. Since the global and
+      // local system matrices are symmetric, we can exploit this property by
+      // building only the lower half of the local matrix and copying the values
+      // to the upper half.
+      for (unsigned int q_point = 0; q_point < n_q_points; ++q_point)
+        {
+          const SymmetricTensor<2, dim, NumberType> &tau =
+            point_data.tau[q_point];
+          const SymmetricTensor<4, dim, NumberType> &Jc =
+            point_data.Jc[q_point];
+          const Tensor<2, dim, NumberType> tau_ns(tau);
 
           // Aliases for readability
           const std::vector<SymmetricTensor<2, dim>> &symm_grad_Nx =
-            scratch.symm_grad_Nx[q_point];
-          const std::vector<Tensor<2, dim>> &grad_Nx = scratch.grad_Nx[q_point];
-          const double JxW = scratch.fe_values_ref.JxW(q_point);
-          const std::vector<Tensor<1, dim, NumberType>> &shape_value =
-            scratch.shape_value[q_point];
+            point_data.symm_grad_Nx[q_point];
+          const std::vector<Tensor<2, dim>> &grad_Nx =
+            point_data.grad_Nx[q_point];
+          const double JxW = fe_values_ref.JxW(q_point);
+          // The internal forces depend on u_n+1 only through the factor
+          // (1-alpha_f)
+          const double JxW_tangent = (1. - data.solid->alpha_f) * JxW;
+
+          // Contract the tangent and the stress with the shape function
+          // gradients once per shape function j, instead of once per pair
+          // (i,j). SymmetricTensor only stores the independent components
+          // (Voigt notation), so that Jc : symm_grad_Nx[j] is a small dense
+          // matrix-vector product and the remaining double contraction in the
+          // (i,j) loop a plain dot product.
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            {
+              scratch.Jc_symm_grad_Nx[j] = Jc * symm_grad_Nx[j];
+              scratch.tau_grad_Nx[j] = tau_ns * grad_Nx[j][component_of_dof[j]];
+            }
 
           for (unsigned int i = 0; i < dofs_per_cell; ++i)
             {
-              const unsigned int component_i =
-                fe.system_to_component_index(i).first;
-              const unsigned int i_group =
-                fe.system_to_base_index(i).first.first;
+              const unsigned int component_i = component_of_dof[i];
 
-              // Residual assembly
-              if (i_group == u_dof)
-                {
-                  // Geometrical stress and body force contribution
-                  data.cell_rhs(i) -=
-                    ((symm_grad_Nx[i] * tau) -
-                     (body_force[component_i] * rho *
-                      scratch.fe_values_ref.shape_value(i, q_point))) *
-                    JxW;
-                  // Mass matrix contribution with acceleration
-                  // Cannot be merged with tangent assembly, since there, the
-                  // matrix symmetry is utilized i.e. only the upper half is
-                  // assembled
-                  for (uint j = 0; j < dofs_per_cell; ++j)
-                    data.cell_rhs(i) -= shape_value[i] * rho * shape_value[j] *
-                                        acc[component_i] * JxW;
-                }
-              else
-                Assert(i_group <= u_dof, ExcInternalError());
+              // Residual assembly. The body force and the inertia
+              // contribution are added globally in assemble_system()
+              data.cell_rhs(i) -= (symm_grad_Nx[i] * tau) * JxW;
 
               // Tangent assembly
               for (unsigned int j = 0; j <= i; ++j)
                 {
-                  const unsigned int component_j =
-                    fe.system_to_component_index(j).first;
-                  const unsigned int j_group =
-                    fe.system_to_base_index(j).first.first;
-
-                  if ((i_group == j_group) && (i_group == u_dof))
-                    {
-                      // The material contribution:
-                      data.cell_matrix(i, j) +=
-                        symm_grad_Nx[i] * Jc * symm_grad_Nx[j] * JxW;
-
-                      // Geometrical stress and mass matrix contributions
-                      if (component_i == component_j)
-                        {
-                          data.cell_matrix(i, j) +=
-                            (grad_Nx[i][component_i] * tau_ns *
-                               grad_Nx[j][component_j] +
-                             shape_value[i][component_i] * rho * alpha_1 *
-                               shape_value[j][component_j]) *
-                            JxW;
-                        }
-                    }
-                  else
-                    Assert((i_group <= u_dof) && (j_group <= u_dof),
-                           ExcInternalError());
+                  // The material contribution:
+                  NumberType K_ij =
+                    symm_grad_Nx[i] * scratch.Jc_symm_grad_Nx[j];
+
+                  // Geometrical stress contribution
+                  if (component_i == component_of_dof[j])
+                    K_ij += grad_Nx[i][component_i] * scratch.tau_grad_Nx[j];
+
+                  data.cell_matrix(i, j) += K_ij * JxW_tangent;
                 }
             }
         }
-
-      // Copy triangular matrix
-      for (unsigned int i = 0; i < dofs_per_cell; ++i)
-        for (unsigned int j = i + 1; j < dofs_per_cell; ++j)
-          data.cell_matrix(i, j) = data.cell_matrix(j, i);
     }
   };
 
@@ -1290,6 +1814,7 @@ namespace Nonlinear_Elasticity
     const BlockVector<double> &solution_delta,
     const BlockVector<double> &acceleration)
   {
+    const Adapter::TraceScope trace("Assemble linear system");
     timer.enter_subsection("Assemble linear system");
     std::cout << " ASM " << std::flush;
 
@@ -1298,28 +1823,109 @@ namespace Nonlinear_Elasticity
 
     const UpdateFlags uf_cell(update_values | update_gradients |
                               update_JxW_values);
-    const UpdateFlags uf_face(update_values | update_JxW_values);
+    const UpdateFlags uf_face(update_values | update_gradients |
+                              update_JxW_values);
 
-    const BlockVector<double> solution_total(
-      get_total_solution(solution_delta));
     typename Assembler_Base<dim, NumberType>::PerTaskData_ASM per_task_data(
       this);
     typename Assembler_Base<dim, NumberType>::ScratchData_ASM scratch_data(
-      fe, qf_cell, uf_cell, qf_face, uf_face, solution_total, acceleration);
+      fe,
+      qf_cell,
+      qf_vol,
+      uf_cell,
+      qf_face,
+      uf_face,
+      total_displacement,
+      solution_delta);
+
+    Assembler<dim, NumberType>      assembler;
+    Assembler_Base<dim, NumberType> &assembler_base = assembler;
+
+    if (parameters.assembly_scheme == "Colored")
+      {
+        // Cells of the same color do not share any DoF, so that the copier
+        // can scatter into the global system concurrently and is executed
+        // right after the worker on the same thread
+        WorkStream::run(
+          colored_cells,
+          [&assembler_base](
+            const typename DoFHandler<dim>::active_cell_iterator &cell,
+            typename Assembler_Base<dim, NumberType>::ScratchData_ASM
+              &scratch,
+            typename Assembler_Base<dim, NumberType>::PerTaskData_ASM &data) {
+            assembler_base.assemble_system_one_cell(cell, scratch, data);
+          },
+          [&assembler_base](
+            const typename Assembler_Base<dim, NumberType>::PerTaskData_ASM
+              &data) { assembler_base.copy_local_to_global_ASM(data); },
+          scratch_data,
+          per_task_data);
+      }
+    else
+      {
+        Assert(parameters.assembly_scheme == "WorkStream", ExcNotImplemented());
+        using CellIterator =
+          typename std::vector<typename DoFHandler<dim>::active_cell_iterator>::
+            const_iterator;
+        WorkStream::run(
+          assembly_cells.cbegin(),
+          assembly_cells.cend(),
+          [&assembler_base](
+            const CellIterator &cell,
+            typename Assembler_Base<dim, NumberType>::ScratchData_ASM
+              &scratch,
+            typename Assembler_Base<dim, NumberType>::PerTaskData_ASM &data) {
+            assembler_base.assemble_system_one_cell(*cell, scratch, data);
+          },
+          [&assembler_base](
+            const typename Assembler_Base<dim, NumberType>::PerTaskData_ASM
+              &data) { assembler_base.copy_local_to_global_ASM(data); },
+          scratch_data,
+          per_task_data);
+      }
 
-    Assembler<dim, NumberType> assembler;
+    // Inertia and body force contributions using the precomputed (and already
+    // condensed) global mass matrix and body force vector:
+    // K += (1-alpha_m) * alpha_1 * M and r += f_body - M * a_n+1-alpha_m
+    tangent_matrix.add((1. - alpha_m) * alpha_1, mass_matrix);
 
-    WorkStream::run(dof_handler_ref.begin_active(),
-                    dof_handler_ref.end(),
-                    static_cast<Assembler_Base<dim, NumberType> &>(assembler),
-                    &Assembler_Base<dim, NumberType>::assemble_system_one_cell,
-                    &Assembler_Base<dim, NumberType>::copy_local_to_global_ASM,
-                    scratch_data,
-                    per_task_data);
+    mass_matrix.vmult(inertia_force, acceleration);
+    constraints.set_zero(inertia_force);
+    system_rhs.add(-1.0, inertia_force, 1.0, body_force_vector);
 
     timer.leave_subsection();
   }
 
+
+
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::assemble_mass_matrix()
+  {
+    mass_matrix       = 0.0;
+    body_force_vector = 0.0;
+
+    // The constraints are applied during the assembly, so that constrained
+    // rows and columns are treated consistently with the tangent matrix
+    Functions::ConstantFunction<dim> rho_f(parameters.rho);
+    MatrixCreator::create_mass_matrix(dof_handler_ref,
+                                      qf_cell,
+                                      mass_matrix.block(u_dof, u_dof),
+                                      &rho_f,
+                                      constraints);
+
+    Vector<double> bf_vector(dim);
+    for (unsigned int d = 0; d < dim; ++d)
+      bf_vector[d] = parameters.rho * body_force[d];
+
+    Functions::ConstantFunction<dim> bf_function(bf_vector);
+    VectorTools::create_right_hand_side(dof_handler_ref,
+                                        qf_cell,
+                                        bf_function,
+                                        body_force_vector.block(u_dof),
+                                        constraints);
+  }
+
   // The constraints for this problem are simple to describe. However, since we
   // are dealing with an iterative Newton method, it should be noted that any
   // displacement constraints should only be specified at the zeroth iteration
@@ -1327,57 +1933,30 @@ namespace Nonlinear_Elasticity
   // constraints are already exactly satisfied.
   template <int dim, typename NumberType>
   void
-  Solid<dim, NumberType>::make_constraints(const int &it_nr)
+  Solid<dim, NumberType>::make_constraints()
   {
-    std::cout << " CST " << std::flush;
-
-    if (it_nr > 1)
-      return;
     constraints.clear();
-    const bool apply_dirichlet_bc = (it_nr == 0);
 
-
-    {
-      // Fix in every direction
-      const int boundary_id = clamped_boundary_id;
-
-      if (apply_dirichlet_bc == true)
-        VectorTools::interpolate_boundary_values(dof_handler_ref,
-                                                 boundary_id,
-                                                 Functions::ZeroFunction<dim>(
-                                                   n_components),
-                                                 constraints,
-                                                 fe.component_mask(u_fe));
-      else
-        VectorTools::interpolate_boundary_values(dof_handler_ref,
-                                                 boundary_id,
-                                                 Functions::ZeroFunction<dim>(
-                                                   n_components),
-                                                 constraints,
-                                                 fe.component_mask(u_fe));
-    }
+    // Fix in every direction
+    VectorTools::interpolate_boundary_values(dof_handler_ref,
+                                             clamped_boundary_id,
+                                             Functions::ZeroFunction<dim>(
+                                               n_components),
+                                             constraints,
+                                             fe.component_mask(u_fe));
 
     if (dim == 3)
       {
         // The FEValuesExtractors allow to fix only a certain direction, in this
         // case the z-direction
-        const unsigned int boundary_id = out_of_plane_clamped_mesh_id;
         const FEValuesExtractors::Scalar z_displacement(2);
 
-        if (apply_dirichlet_bc == true)
-          VectorTools::interpolate_boundary_values(
-            dof_handler_ref,
-            boundary_id,
-            Functions::ZeroFunction<dim>(n_components),
-            constraints,
-            fe.component_mask(z_displacement));
-        else
-          VectorTools::interpolate_boundary_values(
-            dof_handler_ref,
-            boundary_id,
-            Functions::ZeroFunction<dim>(n_components),
-            constraints,
-            fe.component_mask(z_displacement));
+        VectorTools::interpolate_boundary_values(
+          dof_handler_ref,
+          out_of_plane_clamped_mesh_id,
+          Functions::ZeroFunction<dim>(n_components),
+          constraints,
+          fe.component_mask(z_displacement));
       }
 
     constraints.close();
@@ -1389,8 +1968,7 @@ namespace Nonlinear_Elasticity
   Solid<dim, NumberType>::solve_linear_system(
     BlockVector<double> &newton_update)
   {
-    BlockVector<double> A(dofs_per_block);
-    BlockVector<double> B(dofs_per_block);
+    const Adapter::TraceScope trace("Solve linear system");
 
     unsigned int lin_it  = 0;
     double       lin_res = 0.0;
@@ -1398,7 +1976,7 @@ namespace Nonlinear_Elasticity
     {
       timer.enter_subsection("Linear solver");
       std::cout << " SLV " << std::flush;
-      if (parameters.type_lin == "CG")
+      if (parameters.type_lin == "CG" || parameters.type_lin == "Deflated CG")
         {
           const int solver_its = tangent_matrix.block(u_dof, u_dof).m() *
                                  parameters.max_iterations_lin;
@@ -1407,33 +1985,58 @@ namespace Nonlinear_Elasticity
 
           SolverControl solver_control(solver_its, tol_sol);
 
-          GrowingVectorMemory<Vector<double>> GVM;
-          SolverCG<Vector<double>>            solver_CG(solver_control, GVM);
-
-          // TODO: Change to different one
-          PreconditionSelector<SparseMatrix<double>, Vector<double>>
-            preconditioner("ssor", .65);
-          preconditioner.use_matrix(tangent_matrix.block(u_dof, u_dof));
-
-          solver_CG.solve(tangent_matrix.block(u_dof, u_dof),
-                          newton_update.block(u_dof),
-                          system_rhs.block(u_dof),
-                          preconditioner);
+          if (parameters.precision == "Mixed")
+            {
+              mixed_precision_solver.initialize(
+                tangent_matrix.block(u_dof, u_dof), .65);
+              mixed_precision_solver.solve(tangent_matrix.block(u_dof, u_dof),
+                                           newton_update.block(u_dof),
+                                           system_rhs.block(u_dof),
+                                           solver_control);
+            }
+          else if (parameters.matrix_format == "Node-blocked")
+            {
+              node_block_matrix.copy_from(tangent_matrix.block(u_dof, u_dof));
+
+              Adapter::PreconditionNodeBlock<dim> preconditioner;
+              preconditioner.initialize(
+                node_block_matrix,
+                Adapter::PreconditionNodeBlock<dim>::Type::ssor,
+                .65);
+
+              solve_iterative(node_block_matrix,
+                              preconditioner,
+                              newton_update,
+                              solver_control);
+            }
+          else
+            {
+              // TODO: Change to different one
+              PreconditionSelector<SparseMatrix<double>, Vector<double>>
+                preconditioner("ssor", .65);
+              preconditioner.use_matrix(tangent_matrix.block(u_dof, u_dof));
+
+              solve_iterative(tangent_matrix.block(u_dof, u_dof),
+                              preconditioner,
+                              newton_update,
+                              solver_control);
+            }
 
           lin_it  = solver_control.last_step();
           lin_res = solver_control.last_value();
         }
       else if (parameters.type_lin == "Direct")
         {
-          SparseDirectUMFPACK A_direct;
-          A_direct.initialize(tangent_matrix.block(u_dof, u_dof));
-          A_direct.vmult(newton_update.block(u_dof), system_rhs.block(u_dof));
+          direct_solver.factorize(tangent_matrix.block(u_dof, u_dof));
+          direct_solver.vmult(newton_update.block(u_dof),
+                              system_rhs.block(u_dof));
 
           lin_it  = 1;
           lin_res = 0.0;
         }
       else
-        Assert(parameters.type_lin == "Direct" || parameters.type_lin == "CG",
+        Assert(parameters.type_lin == "Direct" || parameters.type_lin == "CG" ||
+                 parameters.type_lin == "Deflated CG",
                ExcMessage("Linear solver type not implemented"));
 
       timer.leave_subsection();
@@ -1445,41 +2048,597 @@ namespace Nonlinear_Elasticity
   }
 
 
+
+  template <int dim, typename NumberType>
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  Solid<dim, NumberType>::solve_iterative(
+    const MatrixType &        matrix,
+    const PreconditionerType &preconditioner,
+    BlockVector<double> &     newton_update,
+    SolverControl &           solver_control)
+  {
+    const Adapter::TraceScope trace("CG");
+    if (parameters.type_lin == "Deflated CG")
+      {
+        // The tangent changes in each Newton iteration, whereas the deflation
+        // space is kept
+        deflated_cg.reset_operator();
+        deflated_cg.solve(matrix,
+                          newton_update.block(u_dof),
+                          system_rhs.block(u_dof),
+                          preconditioner,
+                          solver_control);
+      }
+    else
+      {
+        GrowingVectorMemory<Vector<double>> GVM;
+        SolverCG<Vector<double>>            solver_CG(solver_control, GVM);
+
+        solver_CG.solve(matrix,
+                        newton_update.block(u_dof),
+                        system_rhs.block(u_dof),
+                        preconditioner);
+      }
+  }
+
+
+  // Compute the reduced order model from the snapshots of the offline run.
+  // For the empirical cubature, the internal forces of each cell are
+  // evaluated for each snapshot and projected onto the basis. The projections
+  // are passed to the model snapshot by snapshot, which compresses them, so
+  // that only the projections of a single snapshot are stored for all cells.
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::compute_reduced_order_model(const double step_time)
+  {
+    timer.enter_subsection("Reduced order model");
+
+    rom.compute_basis(snapshots,
+                      parameters.pod_tolerance,
+                      parameters.max_basis_size);
+    rom.set_full_order_step_time(step_time);
+
+    const unsigned int n_modes = rom.size();
+
+    std::vector<Vector<double>> cell_contributions(
+      triangulation.n_active_cells(), Vector<double>(n_modes));
+
+    const UpdateFlags uf_cell(update_values | update_gradients |
+                              update_JxW_values);
+    const UpdateFlags uf_face(update_values | update_gradients |
+                              update_JxW_values);
+
+    // The snapshot is evaluated as total displacement with a zero increment
+    BlockVector<double> snapshot(dofs_per_block);
+    BlockVector<double> zero_delta(dofs_per_block);
+
+    typename Assembler_Base<dim, NumberType>::PerTaskData_ASM per_task_data(
+      this);
+    typename Assembler_Base<dim, NumberType>::ScratchData_ASM scratch_data(
+      fe,
+      qf_cell,
+      qf_vol,
+      uf_cell,
+      qf_face,
+      uf_face,
+      snapshot,
+      zero_delta);
+
+    Assembler<dim, NumberType>       assembler;
+    Assembler_Base<dim, NumberType> &assembler_base = assembler;
+
+    for (unsigned int s = 0; s < snapshots.size(); ++s)
+      {
+        snapshot.block(u_dof) = snapshots[s];
+
+        for (const auto &cell : dof_handler_ref.active_cell_iterators())
+          {
+            assembler_base.assemble_reduced_one_cell(
+              cell, 1.0, false, scratch_data, per_task_data);
+
+            Vector<double> &contribution =
+              cell_contributions[cell->active_cell_index()];
+            contribution = 0;
+            for (unsigned int k = 0; k < n_modes; ++k)
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                contribution(k) +=
+                  per_task_data.cell_rhs(i) *
+                  rom.basis_vector(k)(per_task_data.local_dof_indices[i]);
+          }
+
+        rom.add_training_data(cell_contributions);
+      }
+
+    rom.compute_cubature(parameters.cubature_tolerance);
+    rom.write(case_path + parameters.rom_file);
+
+    std::cout << "Reduced order model written to "
+              << case_path + parameters.rom_file << std::endl;
+
+    timer.leave_subsection();
+  }
+
+
+
+  // Read the reduced order model and set up all data, which remains constant
+  // throughout the online simulation
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::setup_reduced_system()
+  {
+    timer.enter_subsection("Setup system");
+
+    rom.read(case_path + parameters.rom_file,
+             dof_handler_ref.n_dofs(),
+             triangulation.n_active_cells());
+
+    const unsigned int n_modes = rom.size();
+
+    // The snapshots satisfy the homogeneous Dirichlet constraints and so does
+    // the basis. We enforce this explicitly, since the constraints are not
+    // applied anywhere else in the reduced space
+    for (unsigned int k = 0; k < n_modes; ++k)
+      constraints.set_zero(rom.basis_vector(k));
+
+    std::vector<double> weight_of_cell(triangulation.n_active_cells(), 0.0);
+    for (unsigned int i = 0; i < rom.get_cells().size(); ++i)
+      weight_of_cell[rom.get_cells()[i]] = rom.get_weights()[i];
+
+    reduced_cells.clear();
+    reduced_cell_weights.clear();
+    reduced_dofs.clear();
+    monitored_dofs.clear();
+
+    std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+    for (const auto &cell : dof_handler_ref.active_cell_iterators())
+      {
+        bool at_interface = false;
+        for (const auto &face : cell->face_iterators())
+          if (face->at_boundary() &&
+              face->boundary_id() == boundary_interface_id)
+            at_interface = true;
+
+        const double weight = weight_of_cell[cell->active_cell_index()];
+        if (weight > 0 || at_interface)
+          {
+            reduced_cells.push_back(cell);
+            reduced_cell_weights.push_back(weight);
+
+            cell->get_dof_indices(local_dof_indices);
+            reduced_dofs.insert(reduced_dofs.end(),
+                                local_dof_indices.begin(),
+                                local_dof_indices.end());
+            if (at_interface)
+              monitored_dofs.insert(monitored_dofs.end(),
+                                    local_dof_indices.begin(),
+                                    local_dof_indices.end());
+          }
+      }
+    if (probes)
+      {
+        const auto probe_dofs = probes->get_dof_indices();
+        monitored_dofs.insert(monitored_dofs.end(),
+                              probe_dofs.begin(),
+                              probe_dofs.end());
+      }
+
+    for (auto *dofs : {&reduced_dofs, &monitored_dofs})
+      {
+        std::sort(dofs->begin(), dofs->end());
+        dofs->erase(std::unique(dofs->begin(), dofs->end()), dofs->end());
+      }
+
+    // Project the (condensed) mass matrix and body force vector once
+    reduced_mass_matrix.reinit(n_modes, n_modes);
+    reduced_tangent.reinit(n_modes, n_modes);
+    reduced_body_force.reinit(n_modes);
+    reduced_rhs.reinit(n_modes);
+
+    Vector<double> tmp(dof_handler_ref.n_dofs());
+    for (unsigned int k = 0; k < n_modes; ++k)
+      {
+        mass_matrix.block(u_dof, u_dof).vmult(tmp, rom.basis_vector(k));
+        for (unsigned int l = 0; l < n_modes; ++l)
+          reduced_mass_matrix(l, k) = rom.basis_vector(l) * tmp;
+
+        reduced_body_force(k) =
+          rom.basis_vector(k) * body_force_vector.block(u_dof);
+      }
+
+    const std::vector<types::global_dof_index> reduced_block_sizes(1,
+                                                                   n_modes);
+    reduced_displacement.reinit(reduced_block_sizes);
+    reduced_velocity.reinit(reduced_block_sizes);
+    reduced_velocity_old.reinit(reduced_block_sizes);
+    reduced_acceleration.reinit(reduced_block_sizes);
+    reduced_acceleration_old.reinit(reduced_block_sizes);
+    reconstructed_delta.reinit(dofs_per_block);
+    newton_update.reinit(reduced_block_sizes);
+
+    state_variables = {&reduced_displacement,
+                       &reduced_velocity_old,
+                       &reduced_acceleration_old};
+
+    std::cout << "Reduced order model:"
+              << "\n\t Number of modes: " << n_modes
+              << "\n\t Number of cubature cells: " << rom.get_cells().size()
+              << "\n\t Number of reduced cells: " << reduced_cells.size()
+              << "\n\t Reconstructed DoFs per time step: "
+              << monitored_dofs.size() << std::endl;
+
+    timer.leave_subsection();
+  }
+
+
+
+  // Assemble the reduced tangent and residual, i.e., the Galerkin projection
+  // of the full order system onto the basis, using the hyper-reduced cells
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::assemble_reduced_system(
+    const BlockVector<double> &reduced_delta)
+  {
+    const Adapter::TraceScope trace("Assemble reduced system");
+    timer.enter_subsection("Assemble linear system");
+    std::cout << " ASM " << std::flush;
+
+    const unsigned int n_modes = rom.size();
+
+    // The full order state is only needed on the DoFs of the reduced cells.
+    // The displacement is reconstructed in each iteration as well, since it
+    // may have been reset by the coupling
+    reconstruct(reduced_displacement, total_displacement, reduced_dofs);
+    reconstruct(reduced_delta, reconstructed_delta, reduced_dofs);
+
+    reduced_tangent = 0.0;
+    reduced_rhs     = 0.0;
+
+    const UpdateFlags uf_cell(update_values | update_gradients |
+                              update_JxW_values);
+    const UpdateFlags uf_face(update_values | update_gradients |
+                              update_JxW_values);
+
+    typename Assembler_Base<dim, NumberType>::PerTaskData_ASM per_task_data(
+      this);
+    typename Assembler_Base<dim, NumberType>::ScratchData_ASM scratch_data(
+      fe,
+      qf_cell,
+      qf_vol,
+      uf_cell,
+      qf_face,
+      uf_face,
+      total_displacement,
+      reconstructed_delta);
+
+    Assembler<dim, NumberType>       assembler;
+    Assembler_Base<dim, NumberType> &assembler_base = assembler;
+
+    // Basis restricted to the cell and the product of the cell tangent with it
+    FullMatrix<double> local_basis(dofs_per_cell, n_modes);
+    FullMatrix<double> local_tangent_basis(dofs_per_cell, n_modes);
+
+    for (unsigned int c = 0; c < reduced_cells.size(); ++c)
+      {
+        assembler_base.assemble_reduced_one_cell(reduced_cells[c],
+                                                 reduced_cell_weights[c],
+                                                 true,
+                                                 scratch_data,
+                                                 per_task_data);
+
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          for (unsigned int k = 0; k < n_modes; ++k)
+            local_basis(i, k) =
+              rom.basis_vector(k)(per_task_data.local_dof_indices[i]);
+
+        // K_r += Phi_e^T K_e Phi_e and r_r += Phi_e^T r_e
+        per_task_data.cell_matrix.mmult(local_tangent_basis, local_basis);
+        local_basis.Tmmult(reduced_tangent, local_tangent_basis, true);
+        local_basis.Tvmult_add(reduced_rhs, per_task_data.cell_rhs);
+      }
+
+    // Inertia and body force contributions as in assemble_system()
+    reduced_tangent.add((1. - alpha_m) * alpha_1, reduced_mass_matrix);
+
+    Vector<double> inertia(n_modes);
+    reduced_mass_matrix.vmult(inertia, reduced_acceleration.block(u_dof));
+    reduced_rhs.add(-1.0, inertia, 1.0, reduced_body_force);
+
+    timer.leave_subsection();
+  }
+
+
+
+  // The reduced system is small and dense, so that it is solved directly
+  template <int dim, typename NumberType>
+  std::pair<unsigned int, double>
+  Solid<dim, NumberType>::solve_reduced_system(
+    BlockVector<double> &reduced_update)
+  {
+    const Adapter::TraceScope trace("Solve reduced system");
+    timer.enter_subsection("Linear solver");
+    std::cout << " SLV " << std::flush;
+
+    LAPACKFullMatrix<double> tangent(reduced_tangent.m());
+    tangent = reduced_tangent;
+    tangent.compute_lu_factorization();
+
+    reduced_update.block(u_dof) = reduced_rhs;
+    tangent.solve(reduced_update.block(u_dof));
+
+    timer.leave_subsection();
+
+    return std::make_pair(1u, 0.0);
+  }
+
+
+
+  // Newmark updates in reduced coordinates, see update_acceleration() and
+  // update_state_variables()
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::update_reduced_acceleration(
+    const BlockVector<double> &reduced_delta)
+  {
+    reduced_acceleration.equ((1. - alpha_m) * alpha_1, reduced_delta);
+    reduced_acceleration.add(-(1. - alpha_m) * alpha_2,
+                             reduced_velocity_old,
+                             -((1. - alpha_m) * alpha_3 - alpha_m),
+                             reduced_acceleration_old);
+  }
+
+
+
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::update_reduced_state_variables(
+    const BlockVector<double> &reduced_delta)
+  {
+    reduced_displacement += reduced_delta;
+
+    reduced_acceleration.equ(alpha_1, reduced_delta);
+    reduced_acceleration.add(-alpha_2,
+                             reduced_velocity_old,
+                             -alpha_3,
+                             reduced_acceleration_old);
+
+    reduced_velocity.equ(alpha_4, reduced_delta);
+    reduced_velocity.add(alpha_5,
+                         reduced_velocity_old,
+                         alpha_6,
+                         reduced_acceleration_old);
+
+    reduced_velocity.swap(reduced_velocity_old);
+    reduced_acceleration.swap(reduced_acceleration_old);
+
+    // The coupling data and the probes only require the displacement of the
+    // interface and probe cells
+    reconstruct(reduced_displacement, total_displacement, monitored_dofs);
+  }
+
+
+
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::reconstruct(
+    const BlockVector<double> &                 reduced,
+    BlockVector<double> &                       full,
+    const std::vector<types::global_dof_index> &dofs) const
+  {
+    for (const types::global_dof_index i : dofs)
+      {
+        double value = 0.0;
+        for (unsigned int k = 0; k < rom.size(); ++k)
+          value += reduced(k) * rom.basis_vector(k)(i);
+        full(i) = value;
+      }
+  }
+
+
   // Write ouput files
   template <int dim, typename NumberType>
   void
   Solid<dim, NumberType>::output_results() const
   {
     timer.enter_subsection("Output results");
-    DataOut<dim> data_out;
 
-    // Note: There is at least paraView v 5.5 needed to visualize this output
-    DataOutBase::VtkFlags flags;
-    flags.write_higher_order_cells = true;
-    data_out.set_flags(flags);
+    // Snapshot of the displacement, which is owned by the output task. The
+    // DoFHandler is not modified during the time loop. The reduced order
+    // model only keeps the monitored DoFs up to date, so that the full field
+    // is reconstructed here
+    const auto snapshot = [this]() {
+      auto full = std::make_shared<BlockVector<double>>(total_displacement);
+      if (reduced_model_online)
+        reconstruct(reduced_displacement, *full, unconstrained_dofs);
+      return std::shared_ptr<const BlockVector<double>>(full);
+    }();
+
+    const unsigned int index = time.get_timestep() / parameters.output_interval;
+    const double       current_time = time.current();
+
+    const auto write_deformed = [this, snapshot, index, current_time]() {
+      // MappingQEulerian requires a non-block vector
+      Vector<double> soln(snapshot->size());
+      for (unsigned int i = 0; i < soln.size(); ++i)
+        soln(i) = (*snapshot)(i);
+
+      DataOut<dim> data_out;
+      data_out.attach_dof_handler(dof_handler_ref);
+      // Postprocessed data is provided by the Postprocessor
+      Postprocessor<dim> postprocessor;
+      data_out.add_data_vector(soln, postprocessor);
+
+      // To visualize everything on a displaced grid
+      MappingQEulerian<dim> q_mapping(degree, dof_handler_ref, soln);
+      data_out.build_patches(q_mapping,
+                             n_output_subdivisions(),
+                             DataOut<dim>::curved_boundary);
+
+      time_series_writer.write(data_out, index, current_time);
+    };
+
+    // On the reference configuration, only the data of the cached patches is
+    // updated. Each task works on its own copy of the patches
+    const auto write_reference = [this, snapshot, index, current_time]() {
+      Adapter::CachedDataOut<dim> data_out(*reference_output);
+      data_out.build_patches(*snapshot);
+
+      time_series_writer.write(data_out, index, current_time);
+    };
+
+    if (reference_output)
+      output_writer.write(write_reference);
+    else
+      output_writer.write(write_deformed);
+    timer.leave_subsection("Output results");
+  }
 
-    data_out.attach_dof_handler(dof_handler_ref);
-    // Postprocessed data is provided by the Postprocessor
-    Postprocessor<dim> postprocessor;
-    data_out.add_data_vector(total_displacement, postprocessor);
 
-    // To visualize everything on a displaced grid
-    Vector<double> soln(total_displacement.size());
-    for (unsigned int i = 0; i < soln.size(); ++i)
-      soln(i) = total_displacement(i);
-    MappingQEulerian<dim> q_mapping(degree, dof_handler_ref, soln);
 
-    data_out.build_patches(q_mapping, degree, DataOut<dim>::curved_boundary);
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::output_monitoring() const
+  {
+    timer.enter_subsection("Output results");
+
+    // After the update of the state variables, velocity_old holds the
+    // velocity of the current time step. The reduced order model only
+    // reconstructs the displacement in each time step, so that the velocity
+    // is reconstructed here from its reduced coordinates
+    if (probes && reduced_model_online)
+      {
+        BlockVector<double> velocity_full(velocity_old);
+        velocity_full = 0.0;
+        reconstruct(reduced_velocity_old, velocity_full, monitored_dofs);
+        probes->write(time.current(), total_displacement, velocity_full);
+      }
+    else if (probes)
+      probes->write(time.current(), total_displacement, velocity_old);
+
+    if (parameters.interface_output_interval > 0 &&
+        time.get_timestep() % parameters.interface_output_interval == 0)
+      {
+        // The data points of the adapter are numbered in the same order as
+        // the interface faces and their quadrature points are traversed
+        const auto traction = std::make_shared<Vector<double>>();
+        Adapter::project_interface_data<dim>(
+          dof_handler_ref,
+          StaticMappingQ1<dim>::mapping,
+          qf_face,
+          boundary_interface_id,
+          [this](const unsigned int point) {
+            Tensor<1, dim> value;
+            adapter.read_on_quadrature_point_from_block_data(value, point);
+            return value;
+          },
+          *traction);
+
+        // MappingQEulerian requires a non-block vector
+        const auto snapshot =
+          std::make_shared<Vector<double>>(total_displacement.size());
+        for (unsigned int i = 0; i < snapshot->size(); ++i)
+          (*snapshot)(i) = total_displacement(i);
+
+        const unsigned int index =
+          time.get_timestep() / parameters.interface_output_interval;
+        const double current_time = time.current();
+        const bool   reference    = parameters.output_geometry == "Reference" ||
+                               interface_writer.reference_geometry();
+
+        output_writer.write(
+          [this, snapshot, traction, index, current_time, reference]() {
+            Adapter::InterfaceDataOutFaces<dim> data_out(boundary_interface_id);
+            data_out.attach_dof_handler(dof_handler_ref);
+
+            Postprocessor<dim> postprocessor;
+            data_out.add_data_vector(*snapshot, postprocessor);
+            data_out.add_data_vector(
+              *traction,
+              std::vector<std::string>(dim, "traction"),
+              DataOutFaces<dim>::type_dof_data,
+              std::vector<
+                DataComponentInterpretation::DataComponentInterpretation>(
+                dim, DataComponentInterpretation::component_is_part_of_vector));
+
+            if (reference)
+              data_out.build_patches(StaticMappingQ1<dim>::mapping,
+                                     n_output_subdivisions());
+            else
+              {
+                MappingQEulerian<dim> q_mapping(degree,
+                                                dof_handler_ref,
+                                                *snapshot);
+                data_out.build_patches(q_mapping, n_output_subdivisions());
+              }
 
-    std::ostringstream filename;
-    filename << case_path << "solution-"
-             << time.get_timestep() / parameters.output_interval << ".vtk";
+            interface_writer.write(data_out, index, current_time);
+          });
+      }
 
-    std::ofstream output(filename.str().c_str());
-    data_out.write_vtk(output);
     timer.leave_subsection("Output results");
   }
 
+
+
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::write_checkpoint() const
+  {
+    timer.enter_subsection("Write checkpoint");
+
+    // The archive is a copy of the current state, which is written to disk
+    // by the task. The quadrature point data only holds the hyperelastic
+    // material, which has no history, and is set up from the parameters
+    auto checkpoint = std::make_shared<Adapter::CheckpointOut>();
+    checkpoint->save(triangulation);
+    checkpoint->save_dof_numbering(dof_handler_ref);
+    checkpoint->save(time);
+    checkpoint->save_vectors(state_variables);
+    // Snapshots of the reduced order model collected so far (offline mode)
+    checkpoint->save(snapshots);
+
+    const std::string filename = case_path + parameters.checkpoint_file;
+    checkpoint_writer.write(
+      [checkpoint, filename]() { checkpoint->write(filename); });
+
+    std::cout << "\t Writing checkpoint to " << parameters.checkpoint_file
+              << std::endl;
+    timer.leave_subsection("Write checkpoint");
+  }
+
+
+
+  template <int dim, typename NumberType>
+  void
+  Solid<dim, NumberType>::load_checkpoint()
+  {
+    restart->load(time);
+    restart->load_vectors(state_variables);
+
+    std::vector<Vector<double>> stored_snapshots;
+    restart->load(stored_snapshots);
+    if (parameters.rom_mode == "Offline")
+      snapshots = std::move(stored_snapshots);
+    restart.reset();
+
+    // In the online mode, the state variables are the reduced coordinates
+    if (reduced_model_online)
+      reconstruct(reduced_displacement, total_displacement, monitored_dofs);
+
+    std::cout << "Resuming at timestep " << time.get_timestep() << " @ "
+              << time.current() << "s" << std::endl;
+  }
+
+
+
+  template <int dim, typename NumberType>
+  unsigned int
+  Solid<dim, NumberType>::n_output_subdivisions() const
+  {
+    return parameters.output_subdivisions > 0 ? parameters.output_subdivisions :
+                                                degree;
+  }
+
 } // namespace Nonlinear_Elasticity
 
 int
@@ -1535,7 +2694,7 @@ main(int argc, char **argv)
         std::string::npos == pos ? "" : parameter_file.substr(0, pos + 1);
 
       // Dimension is determinded via cmake -DDIM
-      Solid<DIM> solid(case_path);
+      Solid<DIM> solid(case_path, parameter_file);
       solid.run();
     }
   catch (std::exception &exc)
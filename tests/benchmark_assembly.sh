@@ -0,0 +1,53 @@
+#!/bin/bash
+# Measures the wall time of the nonlinear system assembly for both assembly
+# schemes (WorkStream and Colored) over a range of thread counts. The solver
+# is coupled to the write_tester, i.e., it runs the same case as the tests.
+# The solver and the write_tester need to be built beforehand, e.g., by
+# running run_tests.sh.
+#
+# Usage: ./benchmark_assembly.sh [thread counts], default: 1 2 4 8 16 32 64
+echo "Benchmarking the assembly of the nonlinear-elasticity solver"
+
+# Run from this directory
+cd ${0%/*} || exit 1
+
+threads=${@:-"1 2 4 8 16 32 64"}
+
+cd write_tester
+cp ../../nonlinear_elasticity/nonlinear_elasticity . || exit 1
+
+# Extract the wall time of the assembly from the TimerOutput summary
+assembly_time(){
+	awk -F'|' '$2 ~ /Assemble linear system/ {gsub(/[ s]/, "", $4); print $4}' $1
+}
+
+printf "%-12s %8s %14s %10s\n" "Scheme" "Threads" "Assembly [s]" "Speedup"
+for scheme in WorkStream Colored
+do
+	# Each scheme gets its own case directory with a modified parameter file
+	case_dir=benchmark-${scheme}
+	mkdir -p ${case_dir}
+	sed "/subsection Nonlinear solver/a\  set Assembly scheme = ${scheme}" \
+		nonlinear_elasticity.prm > ${case_dir}/nonlinear_elasticity.prm
+
+	reference_time=""
+	for n in ${threads}
+	do
+		log=${case_dir}/nonlinear-writer-${n}.log
+		DEAL_II_NUM_THREADS=${n} ./nonlinear_elasticity ${case_dir}/nonlinear_elasticity.prm &>${log} & ./write_tester &>${case_dir}/tester-${n}.log
+		wait
+
+		# deal.II caps the number of threads at the number of cores
+		n_used=$(grep -o "running with [0-9]* thread" ${log} | awk '{print $3}')
+		if [ "${n_used}" != "${n}" ]
+		then
+			echo "Solver ran with ${n_used:-no} instead of ${n} threads, see ${log}"
+			break
+		fi
+
+		time=$(assembly_time ${log})
+		reference_time=${reference_time:-${time}}
+		speedup=$(awk -v t1=${reference_time} -v tn=${time} 'BEGIN {printf "%.2f", t1 / tn}')
+		printf "%-12s %8s %14s %10s\n" ${scheme} ${n} ${time} ${speedup}
+	done
+done
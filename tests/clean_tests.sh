@@ -7,6 +7,7 @@ rm -fv *.log
 rm -fv ./write_tester/*.log
 rm -fv ./write_tester/*.json
 rm -fvr ./write_tester/precice-run
+rm -fvr ./write_tester/benchmark-*
 rm -fv ./write_tester/linear_elasticity
 rm -fv ./write_tester/nonlinear_elasticity
 rm -fv ./write_tester/*.vtk
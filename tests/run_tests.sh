@@ -57,6 +57,52 @@ sed -i '2d' solution-1.vtk
 numdiff  solution-1.vtk ./reference/${test_name}.output &>${test_name}.log
 print_result ${test_name}
 
+# The interface influence matrix must reproduce the interface displacement
+# of the standard solution path for both time integration schemes. The
+# writer logs show that each run used the settings of its parameter file
+test_name="influence-matrix-theta"
+print_start ${test_name}
+wait
+./linear_elasticity linear_elasticity_influence.prm &>linear-influence-writer.log & ./write_tester &>tester-linear-influence.log
+wait
+sed -i '2d' tester-linear-influence.log
+sed -i '2d' tester-linear-influence.log
+(grep "Time integration: Theta" linear-influence-writer.log &&
+ grep "Interface influence matrix" linear-influence-writer.log &&
+ ! grep "Interface influence matrix" linear-writer.log &&
+ numdiff -r 1e-6 -a 1e-9 tester-linear-influence.log tester-linear.log) &>${test_name}.log
+print_result ${test_name}
+
+# With a spectral radius of one, the generalized-alpha scheme is the
+# trapezoidal rule (alpha_m = alpha_f = 1/2, beta = 1/4, gamma = 1/2). Since
+# the load and the acceleration both start from zero, the initial state is in
+# equilibrium and the scheme produces the same time steps as the theta scheme
+# with theta = 0.5. The theta reference therefore holds up to round-off,
+# which may change the last of the six digits in the output.
+test_name="solver-physics-linear-generalized-alpha"
+print_start ${test_name}
+./linear_elasticity linear_elasticity_alpha.prm &>linear-alpha-writer.log & ./write_tester &>tester-linear-alpha.log
+wait
+sed -i '2d' tester-linear-alpha.log
+sed -i '2d' tester-linear-alpha.log
+sed -i '2d' solution-1.vtk
+(grep "Time integration: Generalized-alpha (spectral radius 1)" linear-alpha-writer.log &&
+ numdiff -r 1e-5 -a 1e-10 solution-1.vtk ./reference/solver-physics-linear.output) &>${test_name}.log
+print_result ${test_name}
+
+test_name="influence-matrix-generalized-alpha"
+print_start ${test_name}
+./linear_elasticity linear_elasticity_alpha_influence.prm &>linear-alpha-influence-writer.log & ./write_tester &>tester-linear-alpha-influence.log
+wait
+sed -i '2d' tester-linear-alpha-influence.log
+sed -i '2d' tester-linear-alpha-influence.log
+(grep "Time integration: Generalized-alpha" linear-alpha-writer.log &&
+ grep "Time integration: Generalized-alpha" linear-alpha-influence-writer.log &&
+ grep "Interface influence matrix" linear-alpha-influence-writer.log &&
+ ! grep "Interface influence matrix" linear-alpha-writer.log &&
+ numdiff -r 1e-6 -a 1e-9 tester-linear-alpha-influence.log tester-linear-alpha.log) &>${test_name}.log
+print_result ${test_name}
+
 test_name="nonlinear-elasticity-writing"
 print_start ${test_name}
 cp ../../nonlinear_elasticity/nonlinear_elasticity .
@@ -73,6 +119,24 @@ sed -i '2d' solution-1.vtk
 numdiff  solution-1.vtk ./reference/${test_name}.output &>${test_name}.log
 print_result ${test_name}
 
+# Selective integration (reduced volumetric quadrature) must reproduce the
+# interface displacement of the full integration up to the quadrature error.
+# The 5 point Gauss rule integrates the part of the volumetric stress, which
+# is linear in the displacement, exactly on the rectangular cells. Only the
+# nonlinear remainder, below 1% of the stress at the strains of this case,
+# carries a quadrature error. With a tip deflection of 3.5e-2 the difference
+# is expected around 1e-7, the tolerance leaves a margin of two decades.
+test_name="selective-integration-nonlinear"
+print_start ${test_name}
+wait
+./nonlinear_elasticity nonlinear_elasticity_selective.prm &>nonlinear-selective-writer.log & ./write_tester &>tester-nonlinear-selective.log
+wait
+sed -i '2d' tester-nonlinear-selective.log
+sed -i '2d' tester-nonlinear-selective.log
+(grep "Selective integration: 5 volumetric" nonlinear-selective-writer.log &&
+ numdiff -a 1e-5 tester-nonlinear-selective.log tester-nonlinear.log) &>${test_name}.log
+print_result ${test_name}
+
 if [ $exit_code -eq 0 ]
 then
     echo "All tests passed."